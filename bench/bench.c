@@ -0,0 +1,238 @@
+/*
+ * ft2pently
+ *
+ * Copyright (C) 2016-2018 NovaSquirrel
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+// times the converter on a set of Famitracker text exports (or modules) and reports throughput and memory use
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+#include "../ft2p.h"
+
+// how long one file took, and how much work it was
+typedef struct bench_result {
+  const char *filename;
+  size_t bytes_in, bytes_out;
+  long rows;
+  int result;
+  double load, read_module;                 // seconds; read_module is for binary modules, which are read into text first
+  double convert_best, convert_total;
+  double phases[PHASE_COUNT];               // summed over every run
+} bench_result;
+
+static double now(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+static void discard(void *user, const char *data, size_t length) {
+  (void)user; (void)data; (void)length;
+}
+
+static void discard_render(void *user, int song_num, const char *name, const char *wav, size_t length) {
+  (void)user; (void)song_num; (void)name; (void)wav; (void)length;
+}
+
+// reads a whole file into memory, with room for a copy right after it
+static char *load_file(const char *filename, size_t *length) {
+  FILE *file = fopen(filename, "rb");
+  if(!file)
+    return NULL;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  rewind(file);
+  char *data = size >= 0 ? malloc(2*size+2) : NULL;
+  if(data && fread(data, 1, size, file) == (size_t)size) {
+    data[size] = 0;
+    *length = size;
+  } else {
+    free(data);
+    data = NULL;
+  }
+  fclose(file);
+  return data;
+}
+
+// writes a string for JSON, with quotes around it
+static void print_json_string(const char *text) {
+  putchar('"');
+  for(; *text; text++) {
+    if(*text == '"' || *text == '\\')
+      putchar('\\');
+    if((unsigned char)*text >= ' ')
+      putchar(*text);
+  }
+  putchar('"');
+}
+
+// counts the rows a converter has to read in an export
+static long count_rows(const char *data, size_t length) {
+  long rows = 0;
+  for(size_t i=0; i+4 <= length; i++)
+    if((i == 0 || data[i-1] == '\n') && !memcmp(data+i, "ROW ", 4))
+      rows++;
+  return rows;
+}
+
+// converts one file "runs" times, keeping its original intact so that every run parses the same thing
+static void bench_file(ft2p_context *ctx, bench_result *result, int runs, const ft2p_options *options) {
+  double start = now();
+  size_t length;
+  char *data = load_file(result->filename, &length);
+  result->load = now() - start;
+  if(!data) {
+    result->result = -1;
+    return;
+  }
+
+  // a binary module is turned into its text export the way ft2p does it, and that's what gets converted
+  if(ft2p_is_module(data, length)) {
+    start = now();
+    size_t text_length;
+    char *text = ft2p_read_module(ctx, data, length, &text_length);
+    result->read_module = now() - start;
+    free(data);
+    data = text ? malloc(2*text_length+2) : NULL;
+    if(data) {
+      memcpy(data, text, text_length);
+      data[text_length] = 0;
+      length = text_length;
+    }
+    free(text);
+    if(!data) {
+      result->result = -1;
+      return;
+    }
+  }
+  result->bytes_in = length;
+  result->rows = count_rows(data, length);
+  result->convert_best = 0;
+
+  char *copy = data + length + 1;
+  for(int i=0; i<runs; i++) {
+    memcpy(copy, data, length+1);
+    start = now();
+    result->result = ft2p_convert(ctx, copy, length, NULL, options);
+    double took = now() - start;
+    result->convert_total += took;
+    for(int phase=0; phase<PHASE_COUNT; phase++)
+      result->phases[phase] += ctx->stats.seconds[phase];
+    if(!i || took < result->convert_best)
+      result->convert_best = took;
+  }
+  result->bytes_out = ctx->out.length;
+  free(data);
+}
+
+int main(int argc, char *argv[]) {
+  int runs = 5, json = 0, num_files = 0, i;
+  ft2p_options options;
+  memset(&options, 0, sizeof(options));
+  options.stats = 1;
+  bench_result *results = calloc(argc, sizeof(bench_result));
+  if(!results)
+    return 1;
+
+  for(i=1; i<argc; i++) {
+    if(!strcmp(argv[i], "-runs") && i+1 < argc)
+      runs = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-json"))
+      json = 1;
+    else if(!strcmp(argv[i], "-autonoise"))
+      options.auto_noise = 1;
+    else if(!strcmp(argv[i], "-autodualdrums"))
+      options.auto_dual_drums = 1;
+    else if(!strcmp(argv[i], "-autodecay"))
+      options.decay_enabled = 1;
+    else if(!strcmp(argv[i], "-dedup"))
+      options.dedup_patterns = 1;
+    else if(!strcmp(argv[i], "-transpose"))
+      options.transpose_patterns = 1;
+    else if(!strcmp(argv[i], "-factor"))
+      options.factor_patterns = 1;
+    else if(!strcmp(argv[i], "-pipeline"))
+      options.pipeline = 1;
+    else if(!strcmp(argv[i], "-songthreads") && i+1 < argc)
+      options.song_threads = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-render"))
+      options.render_rate = 44100;
+    else if(!strcmp(argv[i], "-shortnames"))
+      options.short_names = 1;
+    else
+      results[num_files++].filename = argv[i];
+  }
+  if(!num_files || runs < 1) {
+    fputs("syntax: bench [-runs N] [-json] [-autonoise] [-autodualdrums] [-autodecay] [-dedup] [-transpose] [-factor] [-pipeline] [-songthreads N] [-render] [-shortnames] files...\n", stderr);
+    return 1;
+  }
+
+  ft2p_context *ctx = ft2p_new();
+  if(!ctx) {
+    fputs("Out of memory\n", stderr);
+    return 1;
+  }
+  ctx->log.write = discard;
+  ctx->render.write = discard_render;
+  for(i=0; i<num_files; i++)
+    bench_file(ctx, &results[i], runs, &options);
+  ft2p_free(ctx);
+
+  long peak_rss = 0;
+#ifndef _WIN32
+  struct rusage usage;
+  if(!getrusage(RUSAGE_SELF, &usage))
+    peak_rss = usage.ru_maxrss; // kilobytes on Linux
+#endif
+
+  // rates are from the fastest run, which is the one least disturbed by everything else on the machine
+  if(json)
+    printf("{\"runs\": %i, \"peak_rss_kb\": %ld, \"files\": [", runs, peak_rss);
+  else
+    printf("%-32s %10s %10s %9s %9s %12s %8s\n", "file", "bytes", "rows", "best ms", "mean ms", "rows/s", "MB/s");
+  for(i=0; i<num_files; i++) {
+    bench_result *r = &results[i];
+    double best = r->convert_best > 0 ? r->convert_best : 1e-9;
+    double rows_per_second = r->result ? 0 : r->rows / best, mb_per_second = r->result ? 0 : r->bytes_in / best / 1e6;
+    if(json) {
+      printf("%s\n  {\"file\": ", i ? "," : "");
+      print_json_string(r->filename);
+      printf(", \"result\": %i, \"bytes_in\": %lu, \"bytes_out\": %lu, \"rows\": %ld,"
+             " \"rows_per_second\": %.0f, \"mb_per_second\": %.3f,"
+             " \"phases_ms\": {\"load\": %.3f, \"read_module\": %.3f, \"convert_best\": %.3f, \"convert_mean\": %.3f",
+             r->result, (unsigned long)r->bytes_in, (unsigned long)r->bytes_out, r->rows, rows_per_second, mb_per_second,
+             r->load*1000, r->read_module*1000, r->convert_best*1000, r->convert_total*1000/runs);
+      // the converter's own phases, averaged over the runs
+      for(int phase=0; phase<PHASE_SONG; phase++)
+        printf(", \"%s\": %.3f", ft2p_phase_name(phase), r->phases[phase]*1000/runs);
+      printf("}}");
+    } else {
+      printf("%-32s %10lu %10ld %9.3f %9.3f %12.0f %8.2f%s\n", r->filename, (unsigned long)r->bytes_in, r->rows,
+             r->convert_best*1000, r->convert_total*1000/runs, rows_per_second, mb_per_second, r->result ? "  (failed)" : "");
+    }
+  }
+  if(json)
+    printf("]}\n");
+  else
+    printf("peak RSS: %ld KB\n", peak_rss);
+  free(results);
+  return 0;
+}
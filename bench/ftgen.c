@@ -0,0 +1,208 @@
+/*
+ * ft2pently
+ *
+ * Copyright (C) 2016-2018 NovaSquirrel
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+// makes synthetic Famitracker text exports for benchmarking the converter
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+static uint32_t seed = 1;
+
+// small deterministic random number generator, so the same options always give the same file
+static int random_below(int limit) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed % limit;
+}
+
+static int chance(int percent) {
+  return random_below(100) < percent;
+}
+
+static const char *notes[] = {"C-", "C#", "D-", "D#", "E-", "F-", "F#", "G-", "G#", "A-", "A#", "B-"};
+static const char *drum_notes[] = {"C-3", "C#3", "D-3"};
+static const char *drum_names[] = {"kick", "snare", "clhat"};
+
+// writes an effect that ft2pently supports, with a parameter that makes sense for it
+static void write_effect(int channel) {
+  switch(random_below(7)) {
+    case 0: printf("0%X%X", 3+random_below(2), 7); break;
+    case 1: printf("3%02X", random_below(2)); break;
+    case 2: printf("4%X%X", 2+random_below(4), 1+random_below(8)); break;
+    case 3: printf("G0%X", 1+random_below(3)); break;
+    case 4: printf("%c%X%X", "QR"[random_below(2)], 1+random_below(4), 1+random_below(7)); break;
+    case 5: printf("S0%X", 1+random_below(3)); break;
+    default: printf("F0%X", 3+random_below(5)); break;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int songs = 1, patterns = 8, frames = 16, rows = 64, columns = 1, instruments = 8;
+  int auto_noise = 0, auto_dual_drums = 0, decay = 0, dpcm = 0, mmc5 = 0, density = 30;
+  int volume = -1; // if set, every row changes the volume to it
+  const char *include = NULL;
+  int i, j, k;
+
+  for(i=1; i<argc; i++) {
+    int has_value = i+1 < argc;
+    if(!strcmp(argv[i], "-songs") && has_value)
+      songs = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-patterns") && has_value)
+      patterns = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-frames") && has_value)
+      frames = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-rows") && has_value)
+      rows = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-columns") && has_value)
+      columns = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-instruments") && has_value)
+      instruments = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-density") && has_value)
+      density = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-volume") && has_value)
+      volume = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-seed") && has_value)
+      seed = strtoul(argv[i+1], NULL, 10) | 1;
+    if(!strcmp(argv[i], "-include") && has_value)
+      include = argv[i+1];
+    if(!strcmp(argv[i], "-autonoise"))
+      auto_noise = 1;
+    if(!strcmp(argv[i], "-autodualdrums"))
+      auto_dual_drums = 1;
+    if(!strcmp(argv[i], "-decay"))
+      decay = 1;
+    if(!strcmp(argv[i], "-dpcm"))
+      dpcm = 1;
+    if(!strcmp(argv[i], "-mmc5"))
+      mmc5 = 1;
+  }
+  if(songs < 1 || songs > 64 || patterns < 1 || patterns > 256 || frames < 1 || rows < 1 || rows > 256
+     || columns < 1 || columns > 4 || instruments < 1 || instruments > 63 || volume < -1 || volume > 15) {
+    fputs("syntax: ftgen [-songs 1-64] [-patterns 1-256] [-frames N] [-rows 1-256] [-columns 1-4]\n"
+          "             [-instruments 1-63] [-density percent] [-volume 0-15] [-seed N] [-autonoise]\n"
+          "             [-autodualdrums] [-decay] [-dpcm [-include drums.pently]] [-mmc5] > file.txt\n", stderr);
+    return 1;
+  }
+  int channels = mmc5 ? 6 : 5;
+
+  printf("# FamiTracker text export 0.4.2\n\n");
+  printf("TITLE           \"Synthetic %u\"\nAUTHOR          \"ftgen\"\nCOPYRIGHT       \"\"\n\n", seed);
+  if(auto_noise)
+    printf("COMMENT \"auto noise\"\n");
+  if(auto_dual_drums)
+    printf("COMMENT \"auto dual drums\"\n");
+  if(decay)
+    printf("COMMENT \"auto decay\"\n");
+  if(dpcm) {
+    if(include)
+      printf("COMMENT \"include %s\"\n", include);
+    for(i=0; i<3; i++)
+      printf("COMMENT \"drum %c%s3 %s\"\n", drum_notes[i][0], drum_notes[i][1] == '#' ? "#" : "", drum_names[i]);
+  }
+  printf("\nMACHINE 0\nFRAMERATE 0\nEXPANSION %i\nVIBRATO 1\nSPLIT 32\n\n", mmc5 ? 16 : 0);
+
+  // one volume, arpeggio and duty envelope per instrument, with decays that auto decay can find
+  for(i=0; i<instruments; i++) {
+    printf("MACRO 0 %i -1 -1 0 :", i);
+    int volume = 15 - random_below(4);
+    printf(" %i", volume);
+    if(decay && chance(50)) {
+      int level = (volume<<4), rate = 1+random_below(8);
+      while(level >= 0x08) {
+        level -= rate;
+        printf(" %i", (level+8)>>4);
+      }
+      if((level+8)>>4)
+        printf(" 0");
+    } else {
+      int length = 2+random_below(12);
+      for(j=0; j<length; j++)
+        printf(" %i", volume - volume*j/length);
+      printf(" 0");
+    }
+    printf("\n");
+  }
+  for(i=0; i<instruments; i++)
+    printf("MACRO 1 %i -1 -1 0 : 0 %i %i\n", i, random_below(8), random_below(13));
+  for(i=0; i<instruments; i++)
+    printf("MACRO 4 %i -1 -1 0 : %i %i\n", i, random_below(4), random_below(4));
+  printf("\n");
+
+  // the envelopes after the volume one get in the way of decays, so not every instrument has them;
+  // the last instrument is for the noise channel
+  for(i=0; i<instruments; i++)
+    printf("INST2A03 %3i %5i %3i  -1  -1 %3i \"Inst %i\"\n", i, i, chance(30) ? i : -1, chance(30) ? i : -1, i);
+  printf("INST2A03 %3i %5i %3i  -1  -1 %3i \"Noise\"\n\n", instruments, 0, 0, 0);
+
+  for(int song=0; song<songs; song++) {
+    printf("TRACK %3i %3i %3i \"Song %i\"\n", rows, 3+random_below(6), 150, song+1);
+    printf("COLUMNS :");
+    for(i=0; i<channels; i++)
+      printf(" %i", columns);
+    printf("\n\n");
+
+    for(i=0; i<frames; i++) {
+      printf("ORDER %02X :", i);
+      for(j=0; j<channels; j++)
+        printf(" %02X", random_below(patterns));
+      printf("\n");
+    }
+    printf("\n");
+
+    for(i=0; i<patterns; i++) {
+      printf("PATTERN %02X\n", i);
+      for(int row=0; row<rows; row++) {
+        printf("ROW %02X", row);
+        for(j=0; j<channels; j++) {
+          printf(" : ");
+          if(chance(density) || !row) {
+            if(j == 3)
+              printf("%X-# %02X", random_below(16), instruments);
+            else if(j == 4)
+              printf("%s %02X", dpcm ? drum_notes[random_below(3)] : "...", 0);
+            else if(chance(5))
+              printf("--- ..");
+            else
+              printf("%s%i %02X", notes[random_below(12)], 1+random_below(5), random_below(instruments));
+          } else {
+            printf("... ..");
+          }
+          if(volume >= 0)
+            printf(" %X", volume);
+          else if(chance(10))
+            printf(" %X", 1+random_below(15));
+          else
+            printf(" .");
+          for(k=0; k<columns; k++) {
+            printf(" ");
+            if(chance(8) && j != 4)
+              write_effect(j);
+            else
+              printf("...");
+          }
+        }
+        printf("\n");
+      }
+      printf("\n");
+    }
+  }
+  printf("# End of export\n");
+  return 0;
+}
@@ -0,0 +1,2 @@
+gcc ftgen.c -o ftgen -Wall -std=c99
+gcc bench.c ../ft2p.c -o bench -Wall -std=c99 -pthread
@@ -0,0 +1,1418 @@
+// generated by mkdecay.c; don't edit
+// trie of the volume envelopes that Pently's decay can make, read backwards from the zero at the end;
+// decay_trie[node][volume] is the next node (0 if there's none), and decay_match[node] is
+// (15-starting volume)*16 + (rate-1) for a decay that ends at that node, or 255
+// (lower numbers are preferred when several decays fit)
+#define DECAY_NO_MATCH 255
+
+static const uint16_t decay_trie[1363][16] = {
+  {0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,2,599,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,3,510,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,4,467,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,5,413,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,6,341,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,7,716,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,9,233,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,12,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,17,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,18,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,19,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,20,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,21,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,22,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,23,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,24,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,25,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,26,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,27,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,28,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,29,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,30,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,31,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,32,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,33,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,34,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,35,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,36,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,37,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,38,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,39,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,40,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,41,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,42,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,43,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,44,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,45,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,46,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,47,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,48,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,49,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,50,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,51,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,52,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,54,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,55,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,56,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,57,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,58,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,59,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,60,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,61,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,62,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,63,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,64,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,65,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,66,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,67,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,68,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,69,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,70,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,71,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,72,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,73,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,74,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,75,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,76,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,77,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,78,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,79,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,81,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,82,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,83,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,84,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,85,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,86,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,87,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,88,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,89,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,90,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,91,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,92,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,93,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,94,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,95,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,96,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,97,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,98,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,99,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,100,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,101,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,102,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,103,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,104,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,105,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,106,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,107,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,108,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,109,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,110,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,111,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,112,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,113,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,114,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,115,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,116,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,117,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,118,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,119,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,120,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,121,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,122,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,123,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,124,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,125,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,126,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,127,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,128,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,129,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,130,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,131,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,132,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,133,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,134,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,135,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,136,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,137,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,138,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,139,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,140,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,141,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,142,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,143,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,144,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,145,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,146,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,147,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,148,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,149,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,150,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,151,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,152,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,153,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,154,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,155,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,156,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,157,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,158,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,159,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,160,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,161,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,162,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,163,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,164,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,165,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,166,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,167,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,168,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,169,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,170,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,171,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,172,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,173,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,174,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,175,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,176,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,177,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,178,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,179,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,180,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,181,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,182,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,183,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,184,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,185,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,186,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,187,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,188,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,189,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,190,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,191,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,192,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,193,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,194,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,195,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,196,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,197,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,198,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,199,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,200,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,201,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,202,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,203,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,204,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,205,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,206,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,207,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,208,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,209,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,210,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,211,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,212,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,213,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,214,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,215,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,216,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,217,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,218,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,219,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,220,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,221,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,222,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,223,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,224,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,225},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,226},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,227},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,228},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,229},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,230},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,231},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,232},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,234,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,235,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,236,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,237,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,238,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,239,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,240,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,241,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,242,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,243,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,244,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,245,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,246,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,247,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,248,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,249,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,250,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,251,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,252,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,253,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,254,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,255,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,256,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,257,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,258,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,259,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,260,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,261,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,262,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,263,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,264,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,265,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,266,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,267,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,268,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,269,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,270,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,271,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,272,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,273,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,274,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,275,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,276,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,277,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,278,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,279,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,280,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,281,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,282,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,283,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,284,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,285,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,286,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,287,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,288,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,289,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,290,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,291,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,292,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,293,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,294,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,295,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,296,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,297,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,298,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,299,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,300,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,301,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,302,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,303,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,304,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,305,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,306,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,307,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,308,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,309,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,310,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,311,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,312,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,313,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,314,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,315,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,316,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,317,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,318,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,319,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,320,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,321,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,322,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,323,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,324,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,325,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,326,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,327,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,328,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,329,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,330,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,331,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,332,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,333,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,334,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,335,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,336,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,337},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,338},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,339},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,340},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,342,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,343,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,344,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,345,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,346,952,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,347,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,348,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,349,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,350,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,351,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,352,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,353,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,354,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,355,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,356,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,357,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,358,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,359,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,360,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,361,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,362,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,363,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,364,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,365,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,366,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,367,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,368,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,369,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,370,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,371,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,372,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,373,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,374,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,375,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,376,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,377,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,378,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,379,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,380,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,381,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,382,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,383,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,384,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,385,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,386,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,387,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,388,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,389,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,390,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,391,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,392,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,393,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,394,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,395,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,396,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,397,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,398,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,399,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,400,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,401,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,402,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,403,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,404,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,405,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,406,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,407,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,408,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,409,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,410,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,411},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,412},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,414,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,415,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,416,1008,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,417,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,418,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,419,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,420,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,421,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,422,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,423,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,424,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,425,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,426,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,427,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,428,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,429,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,430,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,431,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,432,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,433,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,434,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,435,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,436,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,437,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,438,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,439,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,440,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,441,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,442,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,443,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,444,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,445,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,446,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,447,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,448,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,449,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,450,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,451,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,452,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,453,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,454,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,455,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,456,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,457,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,458,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,459,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,460,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,461,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,462,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,463,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,464,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,465},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,466},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,468,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,469,546,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,782,470,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,471,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,472,819,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,473,1157,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,474,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,475,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,476,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,477,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,478,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,479,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,480,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,481,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,482,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,483,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,484,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,485,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,486,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,487,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,488,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,489,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,490,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,491,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,492,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,493,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,494,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,495,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,496,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,497,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,498,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,499,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,500,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,501,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,502,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,503,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,504,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,505,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,506,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,507,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,508,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,509},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,511,623,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,512,574,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,513,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,514,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,515,1184,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,516,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,517,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,518,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,519,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,520,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,521,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,522,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,523,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,524,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,525,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,526,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,527,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,528,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,529,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,530,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,531,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,532,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,533,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,534,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,535,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,536,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,537,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,538,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,539,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,540,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,541,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,542,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,543,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,544,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,545},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,547,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,1041,548,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,549,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1267,550,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,551,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,552,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,553,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,554,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,555,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,556,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,557,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,558,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,559,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,560,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,561,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,562,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,563,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,564,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,565,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,566,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,567,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,568,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,569,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,570,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,571,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,572,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,573},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,575,1104,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,1067,576,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,577,1089,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,847,578,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,579,869,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,580,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,581,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,582,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,583,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,584,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,585,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,586,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,587,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,588,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,589,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,590,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,591,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,592,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,593,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,594,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,595,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,596,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,597,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,598},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,600,673,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,601,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,602,658,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,603,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,604,884,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,605,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,606,1324,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,607,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,608,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,609,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,610,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,611,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,612,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,613,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,614,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,615,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,616,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,617,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,618,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,619,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,620,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,621,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,622,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,624,913,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,625,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,626,643,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,627,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1282,628,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,629,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,630,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,631,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,632,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,633,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,634,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,635,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,636,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,637,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,638,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,639,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,640,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,641,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,642,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,644,1301,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,645,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1215,646,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,647,1119,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,648,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,649,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,650,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,651,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,652,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,653,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,654,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,655,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,656,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,657,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,899,659,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,660,1136,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,661,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,662,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1332,663,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,664,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,665,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,666,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,667,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,668,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,669,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,670,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,671,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,672,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,927,674,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,675,688,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,676,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,677,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,678,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,679,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1336,680,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,681,940,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,682,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,683,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,684,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,685,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,686,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,687,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,689,700,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,690,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,691,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,692,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,693,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1309,694,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,695,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,696,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,697,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,698,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,699,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1150,701,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,945,702,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,703,710,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,704,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,705,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,706,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,707,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,708,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,709,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,711,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,712,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,713,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,714,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,715,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,717,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,718,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,719,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,720,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,721,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,722,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,723,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,724,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,725,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,726,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,727,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,728,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,729,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,730,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,731,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,732,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,733,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,734,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,735,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,736,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,737,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,738,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,739,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,740,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,741,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,742,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,743,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,744,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,745,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,746,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,747,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,748,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,749,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,750,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,751,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,752,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,753,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,754,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,755,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,756,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,757,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,758,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,759,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,760,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,761,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,762,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,763,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,764,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,765,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,766,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,767,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,768,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,769,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,770,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,771,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,772,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,773,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,774,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,775,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,776,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,777,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,778,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,779,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,780,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,781,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,783,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,784,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,785,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,786,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,787,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,788,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,789,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,790,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,791,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,792,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,793,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,794,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,795,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,796,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,797,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,798,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,799,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,800,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,801,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,802,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,803,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,804,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,805,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,806,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,807,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,808,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,809,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,810,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,811,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,812,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,813,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,814,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,815,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,816,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,817,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,818,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,820,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,821,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,822,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,823,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,824,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,825,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,826,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,827,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,828,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,829,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,830,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,831,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,832,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,833,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,834,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,835,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,836,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,837,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,838,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,839,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,840,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,841,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,842,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,843,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,844,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,845,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,846,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,848,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,849,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,850,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,851,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,852,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,853,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,854,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,855,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,856,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,857,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,858,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,859,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,860,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,861,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,862,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,863,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,864,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,865,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,866,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,867,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,868,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,870,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,871,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,872,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,873,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,874,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,875,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,876,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,877,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,878,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,879,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,880,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,881,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,882,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,883,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,885,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,886,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,887,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,888,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,889,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,890,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,891,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,892,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,893,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,894,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,895,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,896,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,897,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,898,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,900,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1292,901,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,902,1224,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,903,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,904,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,905,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,906,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,907,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,908,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,909,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,910,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,911,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,912,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,914,1232,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,915,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,916,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1347,917,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,918,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,919,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,920,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,921,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,922,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,923,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,924,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,925,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,926,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,928,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,929,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1354,930,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1127,931,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1351,932,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,933,1145,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,934,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,935,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,936,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,937,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,938,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,939,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,941,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,942,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,943,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,944,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,946,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,947,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,948,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,949,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,950,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,951,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,953,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,954,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,955,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,956,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,957,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,958,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,959,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,960,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,961,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,962,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,963,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,964,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,965,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,966,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,967,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,968,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,969,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,970,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,971,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,972,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,973,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,974,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,975,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,976,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,977,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,978,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,979,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,980,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,981,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,982,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,983,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,984,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,985,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,986,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,987,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,988,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,989,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,990,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,991,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,992,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,993,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,994,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,995,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,996,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,997,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,998,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,999,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1000,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1001,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1002,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1003,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1004,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1005,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,1006,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,1007,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,1009,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,1010,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1011,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1012,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1013,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1014,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1015,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1016,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1017,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1018,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1019,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1020,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1021,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1022,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1023,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1024,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1025,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1026,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1027,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1028,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1029,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1030,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1031,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1032,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1033,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1034,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1035,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1036,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1037,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1038,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1039,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,1040,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1042,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1043,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1044,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1045,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1046,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1047,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1048,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1049,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1050,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1051,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1052,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1053,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1054,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1055,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1056,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1057,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1058,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1059,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1060,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1061,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1062,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1063,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1064,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1065,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,1066,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1068,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1069,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1070,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1071,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1072,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1073,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1074,1316,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1075,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1076,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1077,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1078,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1079,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1080,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1081,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1082,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1083,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1084,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1085,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1086,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1087,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,1088,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1090,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1091,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1092,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1093,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1094,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1095,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1346,1096,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1097,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1098,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1099,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1100,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1101,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1102,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1103,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1105,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1106,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1203,1107,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1108,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1109,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1110,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1111,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1112,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1113,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1114,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1115,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1116,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1117,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1118,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1120,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1121,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1122,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1123,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1124,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1125,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1126,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1128,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1129,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1130,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1131,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1132,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1133,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1134,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1135,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1358,1137,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1138,1241,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1139,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1140,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1141,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1142,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1143,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1144,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1146,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1147,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1148,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1149,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1151,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1152,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1153,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1154,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1155,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1156,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1158,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1159,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1246,1160,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1161,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1162,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1163,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1164,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1165,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1166,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1167,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1168,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1169,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1170,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1171,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1172,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1173,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1174,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1175,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1176,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1177,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1178,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1179,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1180,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1181,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1182,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1183,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,1185,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1186,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1187,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1188,1338,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1189,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1190,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1191,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1192,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1193,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1194,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1195,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1196,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1197,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1198,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1199,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1200,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1201,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,1202,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1204,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1205,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1206,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1353,1207,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1208,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1209,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1210,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1211,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1212,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1213,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1214,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1216,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1217,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1218,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1219,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1220,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1221,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1222,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1223,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1225,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1226,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1227,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1228,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1229,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1230,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1231,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1361,1233,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1234,1311,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1235,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1236,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1237,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1238,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1239,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1240,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1242,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1243,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1244,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1245,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1247,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1248,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1249,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1250,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1251,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1252,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1253,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1254,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1255,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1256,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1257,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1258,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1259,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1260,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1261,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1262,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1263,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1264,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1265,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1266,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1268,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,1269,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1270,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1271,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1272,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1273,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1274,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1275,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1276,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1277,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1278,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1279,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1280,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,1281,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1283,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1360,1284,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1285,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1286,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1287,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1288,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1289,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1290,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1291,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1293,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1294,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1295,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1296,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1297,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1298,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1299,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1300,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1302,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1303,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1304,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1305,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1306,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1307,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1308,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1310,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1312,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1313,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1314,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1315,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1317,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1318,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1319,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1320,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1321,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1322,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,1323,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1325,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1326,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1327,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1328,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1329,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1330,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1331,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1333,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1334,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1335,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1337,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1339,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1340,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1341,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1342,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1343,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1344,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,1345,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1348,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1349,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1350,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,1352,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1355,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1356,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1357,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,1359,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,1362,0,0,0,0,0,0,0,0,0},
+  {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
+};
+
+static const uint8_t decay_match[1363] = {
+  255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+  255,255,255,255,255,255,255,255,192,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,176,255,255,255,255,255,255,255,
+  255,255,255,255,255,255,255,255,160,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,144,255,255,255,255,255,255,255,
+  255,255,255,255,255,255,255,255,128,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,112,255,255,255,255,255,255,255,
+  255,255,255,255,255,255,255,255,96,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,80,255,255,255,255,255,255,255,
+  255,255,255,255,255,255,255,255,64,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,48,255,255,255,255,255,255,255,
+  255,255,255,255,255,255,255,255,32,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,16,255,255,255,255,255,255,255,
+  255,255,255,255,255,255,255,255,0,255,255,255,255,255,255,255,255,255,255,255,193,255,255,255,255,255,255,255,177,255,255,255,
+  255,255,255,255,161,255,255,255,255,255,255,255,145,255,255,255,255,255,255,255,129,255,255,255,255,255,255,255,113,255,255,255,
+  255,255,255,255,97,255,255,255,255,255,255,255,81,255,255,255,255,255,255,255,65,255,255,255,255,255,255,255,49,255,255,255,
+  255,255,255,255,33,255,255,255,255,255,255,255,17,255,255,255,255,255,255,255,1,255,255,255,255,255,255,255,194,255,255,255,
+  255,255,255,255,255,255,255,255,255,255,255,255,146,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,98,255,255,255,
+  255,255,255,255,255,255,255,255,255,255,255,255,50,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,2,255,255,255,
+  255,255,195,255,255,255,179,255,255,255,163,255,255,255,147,255,255,255,131,255,255,255,115,255,255,255,99,255,255,255,83,255,
+  255,255,67,255,255,255,51,255,255,255,35,255,255,255,19,255,255,255,3,255,255,255,255,255,255,255,255,255,255,164,255,255,
+  255,255,255,255,255,255,255,255,255,255,255,255,255,84,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,4,204,200,
+  255,197,255,255,255,255,255,255,255,149,255,255,255,255,255,255,255,101,255,255,255,255,255,255,255,53,255,255,255,255,255,255,
+  255,5,255,255,182,255,255,255,255,255,255,255,255,118,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,6,198,184,
+  183,168,167,255,151,255,135,255,119,255,103,255,87,255,71,255,55,255,39,255,23,255,7,205,202,188,185,255,255,255,152,255,
+  255,255,255,255,255,255,255,255,255,255,255,255,255,255,8,189,186,255,169,255,255,255,255,255,255,255,89,255,255,255,255,255,
+  255,255,9,255,154,255,255,255,255,255,255,255,255,255,255,255,255,10,173,255,155,255,255,255,107,255,255,255,59,255,255,255,
+  11,190,174,255,156,141,255,255,255,255,255,255,255,255,255,12,158,255,255,125,255,255,255,62,255,255,255,13,142,127,111,255,
+  255,255,255,255,255,14,95,79,63,47,31,15,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,162,255,255,
+  255,255,255,255,255,255,255,255,255,255,255,255,255,114,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,66,255,255,
+  255,255,255,255,255,255,255,255,255,255,255,255,255,18,255,255,255,255,180,255,255,255,255,255,255,255,255,255,255,255,255,255,
+  255,255,100,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,20,255,255,255,165,255,255,255,255,255,255,255,117,255,
+  255,255,255,255,255,255,69,255,255,255,255,255,255,255,21,255,255,255,255,255,134,255,255,255,255,255,255,255,255,255,255,255,
+  255,255,255,255,22,255,255,255,255,255,255,255,255,255,255,255,255,255,255,24,255,255,255,255,255,255,105,255,255,255,255,255,
+  255,255,25,170,255,255,138,255,255,255,255,255,255,255,255,255,26,255,171,255,255,255,123,255,255,255,75,255,255,255,27,187,
+  172,157,255,255,255,255,255,255,255,255,255,28,78,255,255,255,29,255,255,93,255,255,255,30,255,255,255,255,255,255,255,178,
+  255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,130,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,82,
+  255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,34,196,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+  116,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,36,255,181,255,255,255,255,255,255,255,133,255,255,255,255,255,
+  255,255,85,255,255,255,255,255,255,255,37,255,255,255,255,255,150,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+  38,255,255,255,255,255,255,255,255,255,255,255,255,255,255,40,255,255,255,255,255,255,121,255,255,255,255,255,255,255,41,255,
+  255,255,255,255,255,255,42,139,255,255,255,91,255,255,255,43,255,255,255,255,255,255,255,255,44,94,255,255,255,45,255,255,
+  109,255,255,255,46,255,255,255,255,255,255,255,255,255,255,132,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,52,
+  255,255,166,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,54,255,255,255,255,255,255,255,255,255,255,255,56,137,
+  255,255,255,255,255,255,255,57,255,255,255,255,255,255,255,58,255,255,255,255,255,255,255,255,60,110,255,255,255,61,255,255,
+  255,255,148,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,68,255,255,255,255,255,255,255,255,255,255,255,255,255,
+  255,70,255,255,255,255,255,255,255,255,255,72,153,255,255,255,255,255,255,255,73,255,255,255,255,255,255,255,74,255,76,126,
+  255,255,255,77,255,255,255,255,255,255,255,86,255,255,255,255,255,255,255,88,255,255,255,90,255,92,255,255,255,255,255,255,
+  255,102,104,255,255,255,106,255,108,120,255,255,255,122,255,124,136,255,140
+};
@@ -17,29 +17,20 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 // https://github.com/Qix-/pently/issues/4
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <ctype.h>
 #include <string.h>
 #include <stdarg.h>
-
-// maximum values, used for array sizes
-#define MAX_EFFECTS     4
-#define MAX_ROWS        256
-#define MAX_FRAMES      128  // real max is 128
-#define MAX_PATTERNS    128  // real max is 128
-#define MAX_INSTRUMENTS 64   // pently limit is 256/5
-#define MAX_MACRO_LEN   255  // real max is like 254?
-#define NUM_OCTAVES     7
-#define NUM_SEMITONES   12
-#define MAX_SFX         64
-#define MAX_DECAY_START 15   // starting volume
-#define MAX_DECAY_RATE  16   // decay rate
-#define MAX_DECAY_LEN   256  // actually goes up to 224 or something but this is to be safe
-#define MAX_SONGS       64
-#define SONG_NAME_LEN   32
-#define MAX_DRUMS       25
+#include <pthread.h>
+#include <time.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+#include "ft2p.h"
+#include "decay.h"
 
 //////////////////// constants ////////////////////
 const char *scale = "cCdDefFgGaAb";
@@ -47,113 +38,10 @@ const char *supported_effects = ".034BCDFGQRSJ";
 const char *chan_name[] = {"pulse1", "pulse2", "triangle", "noise", "drum", "attack"};
 const char *envelope_types[] = {"volume", "arpeggio", "pitch", "hipitch", "duty"};
 
-//////////////////// enums and structs ////////////////////
-// sound channels
-enum {
-  CH_SQUARE1,
-  CH_SQUARE2,
-  CH_TRIANGLE,
-  CH_NOISE,
-  CH_DPCM,      // not supported, but used for Pently drums
-  CH_ATTACK,    // MMC5's first expansion square channel
-  CHANNEL_COUNT
-};
-
-// types of envelopes
-enum {
-  MS_VOLUME,
-  MS_ARPEGGIO,
-  MS_PITCH,
-  MS_HIPITCH,
-  MS_DUTY,
-  MACRO_SET_COUNT
-};
-
-// arpeggio types
-enum {
-  ARP_ABSOLUTE,
-  ARP_RELATIVE,
-  ARP_FIXED
-};
-
-// supported note effects
-enum {
-  FX_NONE     = 0, 
-  FX_ARP      = '0', // arpeggio
-  FX_SLUR     = '3', // enable slur if nonzero
-  FX_VIBRATO  = '4', // vibrato change
-  FX_LOOP     = 'B', // jump to frame X
-  FX_FINE     = 'C', // stop song
-  FX_PAT_CUT  = 'D', // skip to next pattern
-  FX_TEMPO    = 'F', // change tempo or speed
-  FX_DELAY    = 'G', // delay for X frames
-  FX_SLUR_UP  = 'Q', // note for one row, slur into pitch X semitones up
-  FX_SLUR_DN  = 'R', // note for one row, slur into pitch X semitones down
-  FX_DELAYCUT = 'S', // grace note for X frames then rest
-  FX_ATTACK_ON= 'J'  // repurposed to specify attack target
-};
-
-// volumes
-enum {
-  VOL_SAME, // no change
-  VOL_FF,   // 100%
-  VOL_MF,   // 75%
-  VOL_MP,   // 50%
-  VOL_PP,   // 25%
-};
-
-// a sound effect definition, held onto until end of export
-// used for drums and auto-generated noise drums
-typedef struct soundeffect {
-  uint8_t instrument, channel;
-  uint8_t pitch; // pitch offset for auto noise, or 0
-  char name[64];
-} soundeffect;
-
-// a note on a pattern
-typedef struct ftnote {
-  uint8_t octave;             // octave number
-  char note;                  // note name, capitalized if sharp
-  int8_t instrument;          // instrument number
-  uint8_t volume;             // note volume, uses VOL_* values
-  char effect[MAX_EFFECTS];   // effect letter
-  uint8_t param[MAX_EFFECTS]; // effect parameter
-  uint8_t slur;               // nonzero if note has slur
-} ftnote;
-
-// a song and its patterns
-typedef struct ftsong {
-  // Explicitly stated song information
-  char real_name[SONG_NAME_LEN]; // name to display for errors
-  char name[SONG_NAME_LEN];      // sanitized name for the actual file
-  int rows, speed, tempo;
-
-  // Buffers to hold song information
-  int frame[MAX_FRAMES][CHANNEL_COUNT];
-  ftnote pattern[MAX_PATTERNS][CHANNEL_COUNT][MAX_ROWS];
-  uint8_t pattern_used[MAX_PATTERNS][CHANNEL_COUNT];
-  int pattern_length[MAX_PATTERNS][CHANNEL_COUNT];
-  int effect_columns[CHANNEL_COUNT]; // number of effect columns
-  int loop_to;                       // frame to insert the segno at, or -1 for no looping
-
-  // Song status information for parsing purposes
-  int pattern_id, frames;
-} ftsong;
-
-// an instument envelope
-typedef struct ftmacro {
-  int8_t length, loop, release;
-  int8_t arp_type; // relative/absolute? not used by ft2pently
-  int8_t sequence[MAX_MACRO_LEN];
-  uint8_t decay_rate;   // if 0, decay isn't used
-  uint8_t decay_volume; // starting volume to use for decay
-  uint8_t decay_index;  // index decay starts 
-} ftmacro;
-
 //////////////////// functions ////////////////////
 
 // creates a note with some given information
-ftnote make_note(uint8_t octave, char note, int8_t instrument) {
+ftnote make_note(uint8_t octave, char note, int instrument) {
   ftnote new_note;
   memset(&new_note, 0, sizeof(new_note));
   new_note.octave = octave;
@@ -190,16 +78,8 @@ void shift_semitones(ftnote *note, int offset) {
   semitone_to_note(semitones, &note->note, &note->octave);
 }
 
-// asserts that a value is in a given range
-void check_range(const char *name, int value, int low, int high, const char *location) {
-  if(value >= low && value < high)
-    return;
-  printf("Error: %s out of range (%i, must be below %i) %s\n", name, value, high, location?location:"");
-  exit(-1);
-}
-
 // like strncpy but good
-void strlcpy(char *Destination, const char *Source, int MaxLength) { 
+void strlcpy(char *Destination, const char *Source, int MaxLength) {
   // MaxLength is directly from sizeof() so it includes the zero
   int SourceLen = strlen(Source);
   if((SourceLen+1) < MaxLength)
@@ -215,13 +95,6 @@ void remove_line_ending(char *text, char ending) {
     *text = 0;
 }
 
-// removes \n, \r or " if found on the end of a string
-void remove_line_endings(char *buffer) {
-  remove_line_ending(buffer, '\n');
-  remove_line_ending(buffer, '\r');
-  remove_line_ending(buffer, '\"');
-}
-
 // makes a label-friendly version of a name
 char *sanitize_name(char *outbuf, const char *input, int length) {
   char hex[3];
@@ -263,56 +136,318 @@ char *skip_to_number(char *string) {
   return string;
 }
 
-//////////////////// global variables ////////////////////
-ftsong song;  // song being parsed
-ftsong xsong; // song being exported
-
-// module parsing state
-int song_num = 0, sfx_num = 0;
-int8_t instrument[MAX_INSTRUMENTS][MACRO_SET_COUNT];
-uint8_t instrument_used[MAX_INSTRUMENTS];
-uint8_t instrument_ignore[MAX_INSTRUMENTS];
-int num_auto_drums = 0;
-uint8_t auto_drum_noise[MAX_DRUMS];
-uint8_t auto_drum_tri[MAX_DRUMS];
-ftmacro instrument_macro[MACRO_SET_COUNT][MAX_INSTRUMENTS];
-char instrument_name[MAX_INSTRUMENTS][32];
-uint16_t instrument_noise[MAX_INSTRUMENTS]; // each bit in each 16-bit value corresponds to a needed frequency
-char drum_name[NUM_OCTAVES][NUM_SEMITONES][16];
-soundeffect soundeffects[MAX_SFX];
-int duplicate_name_counter = 0;
-char song_name[MAX_SONGS][SONG_NAME_LEN]; // exists solely to check for duplicates
-
-// export options
-int decay_enabled = 0;    // use the decay feature
-int auto_noise = 0;       // automatically convert noise instruments to drums
-int auto_dual_drums = 0;  // automatically convert fixed arpeggio noise instruments to drums (with triangle part)
-int hex_rows = 0;         // display row numbers in hex instead of decimal
-int strict = 0;           // turn warnings into errors
-int tri_sxx_to_cut = 0;   // convert delayed triangle note cuts to regular note cuts
-int dotted_durations = 0; // use dotted durations in the output file
-char decay_envelope[MAX_DECAY_START][MAX_DECAY_RATE][MAX_DECAY_LEN]; // pre-calculated decay tables
-const char *in_filename, *out_filename;
-
-// displays a warning or an error
-void error(int stop, const char *fmt, ...) {
-    if(strict)
+// the keywords at the start of each line of a text export that ft2pently cares about
+enum {
+  KW_NONE,
+  KW_TRACK,
+  KW_PATTERN,
+  KW_ROW,
+  KW_TITLE,
+  KW_AUTHOR,
+  KW_COPYRIGHT,
+  KW_COMMENT,
+  KW_COLUMNS,
+  KW_MACRO,
+  KW_INST2A03,
+  KW_ORDER
+};
+
+// identifies the keyword a line starts with, and points "arg" after the space that follows it
+int find_keyword(char *line, char **arg) {
+  char *space = line;
+  while(*space && *space != ' ')
+    space++;
+  if(*space != ' ')
+    return KW_NONE;
+  *arg = space+1;
+
+  // dispatch on the first letter, then confirm the rest of the word
+  int length = space-line;
+  #define KEYWORD(word, value) if(length == sizeof(word)-1 && !memcmp(line, word, sizeof(word)-1)) return value
+  switch(*line) {
+    case 'R':
+      KEYWORD("ROW", KW_ROW);
+      break;
+    case 'P':
+      KEYWORD("PATTERN", KW_PATTERN);
+      break;
+    case 'T':
+      KEYWORD("TRACK", KW_TRACK);
+      KEYWORD("TITLE", KW_TITLE);
+      break;
+    case 'O':
+      KEYWORD("ORDER", KW_ORDER);
+      break;
+    case 'M':
+      KEYWORD("MACRO", KW_MACRO);
+      break;
+    case 'I':
+      KEYWORD("INST2A03", KW_INST2A03);
+      break;
+    case 'C':
+      KEYWORD("COLUMNS", KW_COLUMNS);
+      KEYWORD("COMMENT", KW_COMMENT);
+      KEYWORD("COPYRIGHT", KW_COPYRIGHT);
+      break;
+    case 'A':
+      KEYWORD("AUTHOR", KW_AUTHOR);
+      break;
+  }
+  #undef KEYWORD
+  return KW_NONE;
+}
+
+// finds the next line of an in-memory file and terminates it in place, removing the line ending;
+// returns NULL once the whole file has been read
+char *next_line(ft2p_context *ctx, char **cursor, char *end, char **line_end) {
+  char *start = *cursor;
+  if(start >= end)
+    return NULL;
+  char *newline = memchr(start, '\n', end-start);
+  if(newline) {
+    *newline = 0;
+    *cursor = newline+1;
+  } else {
+    // the last line has no line ending, and there's no room to add a zero after it, so it gets copied
+    size_t length = end-start;
+    free(ctx->last_line);
+    ctx->last_line = malloc(length+1);
+    if(!ctx->last_line)
+      return NULL;
+    memcpy(ctx->last_line, start, length);
+    ctx->last_line[length] = 0;
+    start = ctx->last_line;
+    newline = start+length;
+    *cursor = end;
+  }
+  if(newline != start && newline[-1] == '\r')
+    *(--newline) = 0;
+  *line_end = newline;
+  return start;
+}
+
+// reads up to "digits" hexadecimal digits, stopping early at anything that isn't one
+int read_hex(const char *text, int digits) {
+  int value = 0;
+  for(; digits; digits--, text++) {
+    if(*text >= '0' && *text <= '9')
+      value = value*16 + *text-'0';
+    else if(*text >= 'A' && *text <= 'F')
+      value = value*16 + *text-'A'+10;
+    else if(*text >= 'a' && *text <= 'f')
+      value = value*16 + *text-'a'+10;
+    else
+      break;
+  }
+  return value;
+}
+
+//////////////////// output ////////////////////
+
+// the converted file is built up in ctx->out and handed to the output sink in one piece at the end
+
+void error(ft2p_context *ctx, int stop, const char *fmt, ...);
+
+// makes room for at least "length" more bytes (plus a terminating zero) at the end of the output buffer
+static char *reserve_output(ft2p_context *ctx, size_t length) {
+  ft2p_buffer *out = &ctx->out;
+  if(out->length + length + 1 > out->capacity) {
+    size_t capacity = out->capacity ? out->capacity : 65536;
+    while(capacity < out->length + length + 1)
+      capacity *= 2;
+    char *grown = realloc(out->data, capacity);
+    if(!grown)
+      error(ctx, 1, "Out of memory");
+    out->data = grown;
+    out->capacity = capacity;
+  }
+  return out->data + out->length;
+}
+
+// writes some bytes to the converted file
+static inline void emit_bytes(ft2p_context *ctx, const char *text, size_t length) {
+  memcpy(reserve_output(ctx, length), text, length);
+  ctx->out.length += length;
+}
+
+// writes a string to the converted file, with no formatting
+static inline void emit_text(ft2p_context *ctx, const char *text) {
+  emit_bytes(ctx, text, strlen(text));
+}
+
+// writes a single character to the converted file
+static inline void emit_char(ft2p_context *ctx, char c) {
+  if(ctx->out.length + 2 > ctx->out.capacity)
+    reserve_output(ctx, 1);
+  ctx->out.data[ctx->out.length++] = c;
+}
+
+// writes a number in decimal
+static void emit_int(ft2p_context *ctx, int value) {
+  char digits[12], *end = digits + sizeof(digits), *start = end;
+  unsigned int magnitude = value < 0 ? -(unsigned)value : (unsigned)value;
+  do {
+    *--start = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while(magnitude);
+  if(value < 0)
+    *--start = '-';
+  emit_bytes(ctx, start, end-start);
+}
+
+// writes a byte as two lowercase hex digits
+static inline void emit_hex2(ft2p_context *ctx, int value) {
+  static const char hex_digits[] = "0123456789abcdef";
+  emit_char(ctx, hex_digits[(value >> 4) & 15]);
+  emit_char(ctx, hex_digits[value & 15]);
+}
+
+// writes formatted text to the converted file
+void emit(ft2p_context *ctx, const char *fmt, ...) {
+  // try formatting straight into the buffer, and if it doesn't fit, make room and do it again
+  size_t room = ctx->out.capacity - ctx->out.length;
+  va_list args;
+  va_start(args, fmt);
+  int length = vsnprintf(ctx->out.data ? ctx->out.data + ctx->out.length : NULL, room, fmt, args);
+  va_end(args);
+  if(length <= 0)
+    return;
+  if((size_t)length >= room) {
+    char *text = reserve_output(ctx, length);
+    va_start(args, fmt);
+    vsnprintf(text, length+1, fmt, args);
+    va_end(args);
+  }
+  ctx->out.length += length;
+}
+
+// sends the converted file to the output sink
+static void flush_output(ft2p_context *ctx) {
+  if(ctx->output.write && ctx->out.length)
+    ctx->output.write(ctx->output.user, ctx->out.data, ctx->out.length);
+}
+
+//////////////////// statistics ////////////////////
+
+static double seconds_now(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// changes what the parser's thread is being timed as doing; returns what it was doing before
+static int enter_phase(ft2p_context *ctx, int phase) {
+  ft2p_stats *stats = &ctx->stats;
+  int old = stats->phase;
+  if(phase != old && ctx->options.stats) {
+    double now = seconds_now();
+    stats->seconds[old] += now - stats->mark;
+    stats->mark = now;
+  }
+  stats->phase = phase;
+  return old;
+}
+
+// fills in the totals at the end of a conversion
+static void finish_stats(ft2p_context *ctx) {
+  ft2p_stats *stats = &ctx->stats;
+  enter_phase(ctx, PHASE_PARSE);
+  if(ctx->options.stats)
+    stats->total = seconds_now() - stats->total;
+  stats->auto_drums = ctx->num_auto_drums;
+  stats->bytes_written = ctx->out.length;
+#ifndef _WIN32
+  struct rusage usage;
+  if(!getrusage(RUSAGE_SELF, &usage))
+    stats->peak_memory_kb = usage.ru_maxrss;
+#endif
+}
+
+#define PIPELINE_QUEUE 4 // finished songs that can wait for an exporter before the parser has to
+
+// a song on its way through the pipeline; it's written with a context of its own, so that songs can be written
+// at the same time, and the parser puts what each one wrote into the real context in the order they were queued
+typedef struct export_job {
+  ftsong *song;
+  int song_num;
+  ft2p_context *ctx; // copy of the parser's context, with its own output, log, costs and counts
+  ft2p_buffer log;
+  ft2p_buffer wav;   // the song played for render_rate, if it was
+  char name[SONG_NAME_LEN];
+  int done, failed;
+} export_job;
+
+// the parser hands finished songs to the exporter threads through a ring of jobs;
+// while exporters are working, the parser may only touch the song it's parsing
+struct ft2p_pipeline {
+  pthread_t *exporter;
+  int exporters;
+  pthread_mutex_t lock;
+  pthread_cond_t changed;    // broadcast whenever a job is queued, taken or done
+  export_job *jobs;          // job n is in jobs[n % capacity] from when it's queued until it's merged
+  int capacity, queued, taken, merged;
+  int finished, abandon;     // the exporters are to stop once the ring is empty, or to skip the songs left in it
+  int failed;                // a song that stopped with an error was merged, so the ones after it are thrown away
+};
+
+void pipeline_sync(ft2p_context *ctx); // the rest of the pipeline is further down
+
+// writes formatted text to the log
+void log_printf(ft2p_context *ctx, const char *fmt, ...) {
+  char text[1024];
+  va_list args;
+  va_start(args, fmt);
+  int length = vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+  if(length >= (int)sizeof(text))
+    length = sizeof(text)-1;
+  if(length <= 0)
+    return;
+  ctx->log.write(ctx->log.user, text, length);
+}
+
+// default log, matching what the command line tool has always done
+static void write_stdout(void *user, const char *data, size_t length) {
+  (void)user;
+  fwrite(data, 1, length, stdout);
+}
+
+// stops the conversion; for a song being written on an exporter thread only that song stops,
+// and the parser finds out when it gets to that song
+static void stop_conversion(ft2p_context *ctx, const char *text) {
+  strlcpy(ctx->error_text, text, sizeof(ctx->error_text));
+  longjmp(ctx->error_jump, 1);
+}
+
+// displays a warning or an error; errors stop the conversion and return to ft2p_convert()
+void error(ft2p_context *ctx, int stop, const char *fmt, ...) {
+    if(ctx->options.strict)
       stop = 1;
+    char text[sizeof(ctx->error_text)];
     va_list args;
     va_start(args, fmt);
-    printf((stop)?"Error: ":"Warning: ");
-    vprintf(fmt, args);
-    putchar('\n');
+    vsnprintf(text, sizeof(text), fmt, args);
     va_end(args);
+    log_printf(ctx, "%s%s\n", (stop)?"Error: ":"Warning: ", text);
     if(stop)
-      exit(-1);
+      stop_conversion(ctx, text);
+}
+
+// asserts that a value is in a given range
+void check_range(ft2p_context *ctx, const char *name, int value, int low, int high, const char *location) {
+  if(value >= low && value < high)
+    return;
+  char text[sizeof(ctx->error_text)];
+  snprintf(text, sizeof(text), "%s out of range (%i, must be below %i) %s", name, value, high, location?location:"");
+  log_printf(ctx, "Error: %s\n", text);
+  stop_conversion(ctx, text);
 }
 
 // creates a string that describes a location in a song
-const char *error_location(ftsong *the_song, int channel, int pattern, int row) {
-  static char buffer[200];
+const char *error_location(ft2p_context *ctx, ftsong *the_song, int channel, int pattern, int row) {
+  char *buffer = ctx->location;
 
-  if(hex_rows) {
+  if(ctx->options.hex_rows) {
     if(row == -1)
       sprintf(buffer, "[%s - %s pattern $%x]", the_song->real_name, chan_name[channel], pattern);
     else
@@ -326,42 +461,513 @@ const char *error_location(ftsong *the_song, int channel, int pattern, int row)
   return buffer;
 }
 
+//////////////////// storage ////////////////////
+
+// makes sure an array has room for at least "needed" items, zeroing any new space
+void *grow_array(ft2p_context *ctx, void *array, int *allocated, int needed, size_t item_size) {
+  if(needed <= *allocated)
+    return array;
+  int new_allocated = *allocated ? *allocated : 16;
+  while(new_allocated < needed)
+    new_allocated *= 2;
+  char *grown = realloc(array, new_allocated * item_size);
+  if(!grown)
+    error(ctx, 1, "Out of memory");
+  memset(grown + *allocated * item_size, 0, (new_allocated - *allocated) * item_size);
+  *allocated = new_allocated;
+  return grown;
+}
+
+// makes sure there's room in the instrument tables for a given instrument number
+void need_instrument(ft2p_context *ctx, int id) {
+  check_range(ctx, "instrument id", id, 0, MAX_ID, NULL);
+  if(id >= ctx->instruments_allocated) {
+    // the exporter threads read these tables, so they have to be idle while they move
+    if(ctx->pipeline)
+      pipeline_sync(ctx);
+    int allocated;
+    #define GROW(table) allocated = ctx->instruments_allocated; \
+      ctx->table = grow_array(ctx, ctx->table, &allocated, id+1, sizeof(*ctx->table))
+    GROW(instrument);
+    GROW(instrument_used);
+    GROW(instrument_ignore);
+    GROW(instrument_name);
+    GROW(instrument_noise);
+    GROW(instrument_alias);
+    #undef GROW
+    ctx->instruments_allocated = allocated;
+  }
+  // instruments stand for themselves until merge_instruments() says otherwise
+  for(; ctx->num_instruments <= id; ctx->num_instruments++)
+    ctx->instrument_alias[ctx->num_instruments] = ctx->num_instruments;
+}
+
+// makes sure there's room for a given macro number, and returns the macro
+ftmacro *need_macro(ft2p_context *ctx, int setting, int id) {
+  check_range(ctx, "macro id", id, 0, MAX_ID, NULL);
+  ctx->instrument_macro[setting] = grow_array(ctx, ctx->instrument_macro[setting], &ctx->macros_allocated[setting], id+1, sizeof(ftmacro));
+  if(id >= ctx->num_macros[setting])
+    ctx->num_macros[setting] = id+1;
+  return &ctx->instrument_macro[setting][id];
+}
+
+// creates an empty song
+ftsong *new_song(ft2p_context *ctx) {
+  ftsong *song = calloc(1, sizeof(ftsong));
+  if(!song)
+    error(ctx, 1, "Out of memory");
+  return song;
+}
+
+// frees a song and all of its patterns
+void free_song(ftsong *song) {
+  if(!song)
+    return;
+  for(int i=0; i<song->patterns_allocated; i++) {
+    for(int j=0; song->pattern[i] && j<CHANNEL_COUNT; j++)
+      free(song->pattern[i]->piece[j]);
+    if(song->pattern[i])
+      free(song->pattern[i]->event[0]);
+    free(song->pattern[i]);
+  }
+  free(song->pattern);
+  free(song->frame);
+  free(song->frame_start);
+  free(song->control);
+  free(song);
+}
+
+// finds a pattern in a song, creating it if it doesn't exist yet
+ftpattern *need_pattern(ft2p_context *ctx, ftsong *song, int id) {
+  if(id < song->patterns_allocated && song->pattern[id])
+    return song->pattern[id];
+  check_range(ctx, "pattern id", id, 0, MAX_ID, song->real_name);
+  song->pattern = grow_array(ctx, song->pattern, &song->patterns_allocated, id+1, sizeof(ftpattern*));
+
+  // allocate all of the channels together with the pattern
+  int rows = song->rows+1;
+  ftpattern *pattern = calloc(1, sizeof(ftpattern) + sizeof(ftnote)*CHANNEL_COUNT*rows);
+  if(!pattern)
+    error(ctx, 1, "Out of memory");
+  for(int channel=0; channel<CHANNEL_COUNT; channel++) {
+    pattern->row[channel] = (ftnote*)(pattern+1) + channel*rows;
+    pattern->length[channel] = song->rows;
+  }
+  song->pattern[id] = pattern;
+  return pattern;
+}
+
+// notes that the parser wrote to a row
+static inline void mark_filled(ftpattern *pattern, int channel, int row) {
+  pattern->filled[channel][row/32] |= 1u << (row%32);
+}
+
+// brings a channel's running state up to the row that's about to be read, so it describes every row before it;
+// rows normally come in order and each one only gets looked at once, but if they go backwards it starts over
+static ftchannel_state *decode_up_to(ftchannel_state *state, const ftnote *notes, int row) {
+  if(!state->next_row || row < state->next_row) {
+    state->next_row = 0;
+    state->last_volume = VOL_SAME;
+    state->last_instrument = -1;
+    state->last_note = -1;
+  }
+  for(; state->next_row < row; state->next_row++) {
+    const ftnote *note = &notes[state->next_row];
+    if(note->volume)
+      state->last_volume = note->volume;
+    if(note->note) {
+      state->last_note = state->next_row;
+      if(note->instrument != -1)
+        state->last_instrument = note->instrument;
+    }
+  }
+  return state;
+}
+
+// returns a pattern's notes on a channel, or NULL if the pattern never appeared
+static inline ftnote *get_pattern(ftsong *song, int id, int channel) {
+  if(id < 0 || id >= song->patterns_allocated || !song->pattern[id])
+    return NULL;
+  return song->pattern[id]->row[channel];
+}
+
+// returns how many rows of a pattern get played before the next frame
+static inline int get_pattern_length(ftsong *song, int id, int channel) {
+  if(id < 0 || id >= song->patterns_allocated || !song->pattern[id])
+    return song->rows;
+  return song->pattern[id]->length[channel];
+}
+
+// returns 1 if a pattern has notes on a channel
+static inline int get_pattern_used(ftsong *song, int id, int channel) {
+  if(id < 0 || id >= song->patterns_allocated || !song->pattern[id])
+    return 0;
+  return song->pattern[id]->used[channel];
+}
+
+// describes what's on a row, or returns 0 if it's empty
+static uint8_t event_flags(const ftnote *note) {
+  uint8_t flags = 0;
+  if(note->note)
+    flags |= EVENT_NOTE;
+  if(isalnum(note->note))
+    flags |= EVENT_PLAYED;
+  if(note->volume)
+    flags |= EVENT_VOLUME;
+  for(int i=0; i<MAX_EFFECTS; i++)
+    if(note->effect[i] && note->effect[i] != '.') {
+      flags |= EVENT_EFFECT;
+      if(note->effect[i] == FX_TEMPO || note->effect[i] == FX_ATTACK_ON)
+        flags |= EVENT_CONTROL;
+    }
+  return flags;
+}
+
+// lists the events in each of a song's patterns, once all of its rows have been read
+// (slurs and repeated rows can change rows other than the one being read, so it waits until then)
+void index_song_events(ft2p_context *ctx, ftsong *song) {
+  ftevent found[CHANNEL_COUNT*MAX_ROWS];
+  for(int i=0; i<song->patterns_allocated; i++) {
+    ftpattern *p = song->pattern[i];
+    if(!p)
+      continue;
+    int total = 0;
+    for(int j=0; j<CHANNEL_COUNT; j++) {
+      const ftnote *notes = p->row[j];
+      int first = total;
+      p->used[j] = 0;
+      for(int word=0; word*32 < song->rows; word++) {
+        uint32_t bits = p->filled[j][word];
+        for(int row=word*32; bits && row<song->rows; row++, bits >>= 1) {
+          if(!(bits & 1))
+            continue;
+          uint8_t flags = event_flags(&notes[row]);
+          if(!flags)
+            continue;
+          found[total++] = (ftevent){row, flags};
+          if(flags & EVENT_PLAYED)
+            p->used[j] = 1;
+        }
+      }
+      p->events[j] = total - first;
+    }
+    int controls = 0;
+    for(int k=0; k<total; k++)
+      controls += (found[k].flags & EVENT_CONTROL) != 0;
+
+    // each channel's control events go in the same block, after all of the events
+    free(p->event[0]);
+    ftevent *events = malloc(sizeof(ftevent) * (total + controls ? total + controls : 1));
+    if(!events)
+      error(ctx, 1, "Out of memory");
+    memcpy(events, found, sizeof(ftevent) * total);
+    ftevent *control = events + total;
+    for(int j=0; j<CHANNEL_COUNT; j++) {
+      p->event[j] = events;
+      p->control[j] = control;
+      for(int k=0; k<p->events[j]; k++)
+        if(events[k].flags & EVENT_CONTROL)
+          *control++ = events[k];
+      p->controls[j] = control - p->control[j];
+      events += p->events[j];
+    }
+  }
+}
+
+// adds an entry to the end of a song's timeline, or returns the last one if it's for the same row
+static ftcontrol *add_control(ft2p_context *ctx, ftsong *song, int row) {
+  if(song->controls && song->control[song->controls-1].row == row)
+    return &song->control[song->controls-1];
+  song->control = grow_array(ctx, song->control, &song->controls_allocated, song->controls+1, sizeof(ftcontrol));
+  ftcontrol *control = &song->control[song->controls++];
+  *control = (ftcontrol){row, 0, 0, -1, 0};
+  return control;
+}
+
+// makes a song's timeline from its frames and its patterns' control events, once the events have been listed;
+// the conductor only has to follow it, instead of looking through every row of every frame
+void build_song_timeline(ft2p_context *ctx, ftsong *song) {
+  free(song->frame_start);
+  song->frame_start = malloc(sizeof(int) * (song->frames+1));
+  if(!song->frame_start)
+    error(ctx, 1, "Out of memory");
+  song->controls = 0;
+
+  int start = 0;
+  for(int i=0; i<song->frames; i++) {
+    // the frame ends at the shortest of its patterns
+    int length = MAX_ROWS, cursor[CHANNEL_COUNT] = {0};
+    ftpattern *pattern[CHANNEL_COUNT];
+    for(int j=0; j<CHANNEL_COUNT; j++) {
+      int id = song->frame[i][j];
+      pattern[j] = get_pattern(song, id, j) ? song->pattern[id] : NULL;
+      if(get_pattern_length(song, id, j) < length)
+        length = get_pattern_length(song, id, j);
+    }
+    song->frame_start[i] = start;
+    if(song->loop_to == i && song->loop_to)
+      add_control(ctx, song, start)->segno = 1;
+
+    // go through the channels' control events together, a row at a time
+    while(1) {
+      int row = length;
+      for(int j=0; j<CHANNEL_COUNT; j++)
+        if(pattern[j] && cursor[j] < pattern[j]->controls[j] && pattern[j]->control[j][cursor[j]].row < row)
+          row = pattern[j]->control[j][cursor[j]].row;
+      if(row >= length)
+        break;
+      int speed = 0, tempo = 0, attack = -1;
+      for(int j=0; j<CHANNEL_COUNT; j++) {
+        if(!pattern[j] || cursor[j] == pattern[j]->controls[j] || pattern[j]->control[j][cursor[j]].row != row)
+          continue;
+        cursor[j]++;
+        ftnote *note = &pattern[j]->row[j][row];
+        for(int fx=0; fx<MAX_EFFECTS; fx++)
+          if(note->effect[fx] == FX_TEMPO) {
+            if(note->param[fx] < 0x20)
+              speed = note->param[fx];
+            else
+              tempo = note->param[fx];
+          } else if(note->effect[fx] == FX_ATTACK_ON && j == CH_ATTACK)
+            attack = note->param[fx];
+      }
+      if(speed||tempo||(attack>=0)) {
+        ftcontrol *control = add_control(ctx, song, start+row);
+        control->speed = speed;
+        control->tempo = tempo;
+        control->attack = attack;
+      }
+    }
+    start += length;
+  }
+  song->frame_start[song->frames] = start;
+}
+
+// returns the index of a pattern's first event at or after a row
+static int find_event(const ftpattern *p, int channel, int row) {
+  int low = 0, high = p->events[channel];
+  while(low < high) {
+    int middle = (low + high) / 2;
+    if(p->event[channel][middle].row < row)
+      low = middle+1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
 // finds a auto/dual drum automatically, or creates a new one if necessary
-uint8_t find_auto_drum(uint8_t noise, uint8_t triangle) {
-  for(int i=0; i<num_auto_drums; i++) {
-    if(auto_drum_noise[i] == noise && auto_drum_tri[i] == triangle)
+uint8_t find_auto_drum(ft2p_context *ctx, int noise, uint8_t triangle) {
+  for(int i=0; i<ctx->num_auto_drums; i++) {
+    if(ctx->auto_drum_noise[i] == noise && ctx->auto_drum_tri[i] == triangle)
       return i;
   }
 //  printf("Adding drum combo: noise %x tri %x\n", noise, triangle);
-  if(num_auto_drums == MAX_DRUMS)
-    error(1, "Maximum number of drums is %i", MAX_DRUMS);
+  // past MAX_DRUMS, the ones that sound the most alike are merged once all of the songs have been written
+  if(ctx->num_auto_drums == MAX_AUTO_DRUMS)
+    error(ctx, 1, "Maximum number of drums is %i", MAX_AUTO_DRUMS);
+
+  ctx->auto_drum_noise[ctx->num_auto_drums] = noise;
+  ctx->auto_drum_tri[ctx->num_auto_drums] = triangle;
+
+  return ctx->num_auto_drums++;
+}
 
-  auto_drum_noise[num_auto_drums] = noise;
-  auto_drum_tri[num_auto_drums] = triangle;
+// remembers that an automatic drum is played at "offset" in the output, in case it gets renamed later
+static void add_drum_ref(ft2p_context *ctx, size_t offset, const char *drum) {
+  ctx->drum_refs = grow_array(ctx, ctx->drum_refs, &ctx->drum_refs_allocated, ctx->num_drum_refs+1, sizeof(ftdrumref));
+  ctx->drum_refs[ctx->num_drum_refs].offset = offset;
+  ctx->drum_refs[ctx->num_drum_refs++].length = strlen(drum);
+}
+
+//////////////////// ROM size estimates ////////////////////
+// these follow how pentlyas encodes what ft2pently writes, but they're estimates; pentlyas has the final word
+
+// bytes for a note, rest or wait of some number of rows; Pently notes can be 1, 2, 3, 4, 6, 8, 12 or 16 rows long
+// and anything else takes a note plus waits
+static int duration_bytes(int rows) {
+  static const int lengths[] = {16, 12, 8, 6, 4, 3, 2, 1};
+  int bytes = 0;
+  for(int i=0; rows > 0; ) {
+    if(rows >= lengths[i]) {
+      rows -= lengths[i];
+      bytes++;
+    } else {
+      i++;
+    }
+  }
+  return bytes;
+}
+
+// remembers how big a pattern that was just written is
+static void add_pattern_cost(ft2p_context *ctx, const ftlabel *label, int bytes) {
+  ft2p_costs *costs = &ctx->costs;
+  costs->pattern = grow_array(ctx, costs->pattern, &costs->patterns_allocated, costs->num_patterns+1, sizeof(ft2p_pattern_cost));
+  costs->pattern[costs->num_patterns].label = *label;
+  costs->pattern[costs->num_patterns].bytes = bytes;
+  costs->num_patterns++;
+  if(costs->num_songs)
+    costs->song[costs->num_songs-1].patterns += bytes;
+}
+
+// sorts pattern costs biggest first
+static int compare_pattern_costs(const void *a, const void *b) {
+  const ft2p_pattern_cost *x = a, *y = b;
+  if(x->bytes != y->bytes)
+    return y->bytes - x->bytes;
+  if(x->label.song_num != y->label.song_num)
+    return x->label.song_num - y->label.song_num;
+  if(x->label.channel != y->label.channel)
+    return x->label.channel - y->label.channel;
+  if(x->label.id != y->label.id)
+    return x->label.id - y->label.id;
+  return x->label.row - y->label.row;
+}
+
+// writes a pattern's name into a string; short names have the channel as a letter between the numbers
+static void pattern_name(char *name, size_t size, const ftlabel *label, int short_names) {
+  if(short_names) {
+    int length = snprintf(name, size, "p%i%c%i", label->song_num, 'a'+label->channel, label->id);
+    if(label->row)
+      snprintf(name+length, size-length, "r%i", label->row);
+  } else if(label->row)
+    snprintf(name, size, "pat_%i_%i_%i_%i", label->song_num, label->channel, label->id, label->row);
+  else
+    snprintf(name, size, "pat_%i_%i_%i", label->song_num, label->channel, label->id);
+}
+
+// writes the name of the constant that ca65 output numbers a pattern with, which is its name in capitals
+static void pattern_constant(char *name, size_t size, const ftlabel *label, int short_names) {
+  pattern_name(name, size, label, short_names);
+  for(; *name; name++)
+    *name = toupper(*name);
+}
+
+// writes formatted text to a sink
+static void sink_printf(const ft2p_sink *sink, const char *fmt, ...) {
+  char text[512];
+  va_list args;
+  va_start(args, fmt);
+  int length = vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+  if(length >= (int)sizeof(text))
+    length = sizeof(text)-1;
+  if(length > 0)
+    sink->write(sink->user, text, length);
+}
+
+void ft2p_write_costs(ft2p_context *ctx, const ft2p_sink *sink, int json, int top) {
+  ft2p_costs *costs = &ctx->costs;
+  qsort(costs->pattern, costs->num_patterns, sizeof(ft2p_pattern_cost), compare_pattern_costs);
+  if(top > costs->num_patterns)
+    top = costs->num_patterns;
+
+  if(json) {
+    sink_printf(sink, "{\"songs\": [");
+    for(int i=0; i<costs->num_songs; i++) {
+      ft2p_song_cost *song = &costs->song[i];
+      sink_printf(sink, "%s\n  {\"name\": \"%s\", \"patterns\": %i, \"conductor\": %i, \"total\": %i}", i?",":"",
+                  song->name, song->patterns, song->conductor, song->patterns+song->conductor);
+    }
+    sink_printf(sink, "],\n \"instruments\": %i, \"sfx\": %i, \"drums\": %i, \"total\": %i,\n \"largest_patterns\": [",
+                costs->instruments, costs->sfx, costs->drums, costs->total);
+    for(int i=0; i<top; i++) {
+      char name[64];
+      pattern_name(name, sizeof(name), &costs->pattern[i].label, ctx->options.short_names);
+      sink_printf(sink, "%s\n  {\"name\": \"%s\", \"bytes\": %i}", i?",":"", name, costs->pattern[i].bytes);
+    }
+    sink_printf(sink, "]");
+    if(ctx->options.budget)
+      sink_printf(sink, ",\n \"budget\": %i", ctx->options.budget);
+    sink_printf(sink, "}\n");
+    return;
+  }
+
+  sink_printf(sink, "Estimated ROM bytes:\n");
+  for(int i=0; i<costs->num_songs; i++) {
+    ft2p_song_cost *song = &costs->song[i];
+    sink_printf(sink, "  song %-24s %6i (patterns %i, conductor %i)\n", song->name, song->patterns+song->conductor, song->patterns, song->conductor);
+  }
+  sink_printf(sink, "  instruments %24i\n  sfx %32i\n  drums %30i\n  total %30i", costs->instruments, costs->sfx, costs->drums, costs->total);
+  if(ctx->options.budget)
+    sink_printf(sink, " of %i", ctx->options.budget);
+  sink_printf(sink, "\n");
+  if(top) {
+    sink_printf(sink, "Largest patterns:\n");
+    for(int i=0; i<top; i++) {
+      char name[64];
+      pattern_name(name, sizeof(name), &costs->pattern[i].label, ctx->options.short_names);
+      sink_printf(sink, "  %-29s %6i\n", name, costs->pattern[i].bytes);
+    }
+  }
+}
+
+const char *ft2p_phase_name(int phase) {
+  static const char *phase_names[PHASE_SONG] = {"parse", "macros", "patterns", "conductor", "auto_noise", "include", "render"};
+  return phase >= 0 && phase < PHASE_SONG ? phase_names[phase] : NULL;
+}
+
+void ft2p_write_stats(ft2p_context *ctx, const ft2p_sink *sink, int json) {
+  ft2p_stats *stats = &ctx->stats;
+  if(json) {
+    sink_printf(sink, "{\"phases_ms\": {");
+    for(int i=0; i<PHASE_SONG; i++)
+      sink_printf(sink, "%s\"%s\": %.3f", i?", ":"", ft2p_phase_name(i), stats->seconds[i]*1000);
+    sink_printf(sink, "},\n \"total_ms\": %.3f, \"lines\": %ld, \"rows\": %ld, \"notes\": %ld, \"patterns_written\": %i,"
+                " \"patterns_empty\": %i,\n \"songs_cached\": %i, \"auto_drums\": %i, \"bytes_written\": %lu, \"peak_memory_kb\": %ld}\n",
+                stats->total*1000, stats->lines, stats->rows, stats->notes, stats->patterns_written,
+                stats->patterns_empty, stats->songs_cached, stats->auto_drums, (unsigned long)stats->bytes_written, stats->peak_memory_kb);
+    return;
+  }
 
-  return num_auto_drums++;
+  sink_printf(sink, "Time (ms):\n");
+  for(int i=0; i<PHASE_SONG; i++)
+    sink_printf(sink, "  %-22s %10.3f\n", ft2p_phase_name(i), stats->seconds[i]*1000);
+  sink_printf(sink, "  %-22s %10.3f\n", "total", stats->total*1000);
+  sink_printf(sink, "Counts:\n  %-22s %10ld\n  %-22s %10ld\n  %-22s %10ld\n  %-22s %10i\n  %-22s %10i\n"
+              "  %-22s %10i\n  %-22s %10i\n  %-22s %10lu\n  %-22s %10ld\n",
+              "lines parsed", stats->lines, "rows parsed", stats->rows, "notes written", stats->notes,
+              "patterns written", stats->patterns_written, "empty patterns skipped", stats->patterns_empty,
+              "songs from the cache", stats->songs_cached, "auto drums", stats->auto_drums, "bytes written", (unsigned long)stats->bytes_written,
+              "peak memory (KB)", stats->peak_memory_kb);
 }
 
 // writes the numbers for an instrument's envelope, including the loop point
-void write_macro(FILE *file, ftmacro *macro) {
+void write_macro(ft2p_context *ctx, const ftmacro *macro) {
   int i;
   for(i=0; i<macro->length; i++) {
     if(i == macro->loop)
-      fprintf(file, "| ");
-    fprintf(file, "%i ", macro->sequence[i]);
+      emit_bytes(ctx, "| ", 2);
+    emit_int(ctx, macro->sequence[i]);
+    emit_char(ctx, ' ');
   }
-  fprintf(file, "\r\n");
+  emit_bytes(ctx, "\r\n", 2);
+}
+
+// writes a note name, where sharp notes are uppercase
+static inline void write_note_name(ft2p_context *ctx, char note) {
+  static const char *const note_names[] = {"a", "a#", "b", "b#", "c", "c#", "d", "d#", "e", "e#", "f", "f#", "g", "g#"};
+  int letter = tolower(note) - 'a';
+  if(letter >= 0 && letter < 7)
+    emit_text(ctx, note_names[letter*2 + (isupper(note) != 0)]);
+  else
+    emit(ctx, "%c%s", tolower(note), isupper(note)?"#":"");
 }
 
 // writes an octave using ' and ,
-void write_octave(FILE *file, int octave) {
+void write_octave(ft2p_context *ctx, int octave) {
+  static const char *const octave_marks[] = {",,", ",", "", "'", "''", "'''", "''''", "'''''", "''''''", "'''''''"};
+  if(octave >= 0 && octave < (int)(sizeof(octave_marks)/sizeof(*octave_marks))) {
+    emit_text(ctx, octave_marks[octave]);
+    return;
+  }
   int i;
   if(octave > 2)
     for(i=2; i!= octave; i++)
-      fputc('\'', file);
+      emit_char(ctx, '\'');
   if(octave < 2)
     for(i=2; i!= octave; i--)
-      fputc(',', file);
+      emit_char(ctx, ',');
 }
 
 // flags for write_instrument
@@ -370,427 +976,3295 @@ enum {
   ALLOW_DECAY = 2,
 };
 
-// writes an instrument's envelopes
-void write_instrument(FILE *file, int i, int flags) {
-  unsigned int num_macro_volume = (unsigned)instrument[i][MS_VOLUME];
-  unsigned int num_macro_duty   = (unsigned)instrument[i][MS_DUTY];
-  unsigned int num_macro_arp    = (unsigned)instrument[i][MS_ARPEGGIO];
+// picks the envelopes an instrument is written with, cutting the volume envelope off where an automatic decay
+// can take over; returns the decay rate, or 0 if there's no decay
+static int instrument_envelopes(ft2p_context *ctx, int i, int flags, ftmacro *volume, const ftmacro **duty, const ftmacro **arp) {
+  *duty = ctx->instrument[i][MS_DUTY] >= 0 ? &ctx->instrument_macro[MS_DUTY][ctx->instrument[i][MS_DUTY]] : NULL;
+  *arp = ctx->instrument[i][MS_ARPEGGIO] >= 0 ? &ctx->instrument_macro[MS_ARPEGGIO][ctx->instrument[i][MS_ARPEGGIO]] : NULL;
+  volume->length = 0;
+  if(ctx->instrument[i][MS_VOLUME] < 0)
+    return 0;
+  // make a copy of the macro that can be modified without changing the original
+  *volume = ctx->instrument_macro[MS_VOLUME][ctx->instrument[i][MS_VOLUME]];
+
+  // do not use decay if it would interfere with the arpeggio or duty envelopes, or if disallowed
+  if((volume->decay_rate && ctx->options.decay_enabled && (flags & ALLOW_DECAY))
+     && (!*arp || ((*arp)->length < volume->decay_index && (*arp)->loop == -1))
+     && (!*duty || ((*duty)->length < volume->decay_index && (*duty)->loop == -1))) {
+    // if a decay can be used, cut off the volume envelope at the decay point
+    volume->sequence[volume->decay_index] = volume->decay_volume;
+    volume->length = volume->decay_index + 1;
+    return volume->decay_rate;
+  }
+  return 0;
+}
+
+// writes an instrument's envelopes; returns how many frames long the envelopes are
+int write_instrument(ft2p_context *ctx, int i, int flags) {
+  ftmacro volume;
+  const ftmacro *duty, *arp;
+  int frames = 0, decay_rate = instrument_envelopes(ctx, i, flags, &volume, &duty, &arp);
+
+  // write the envelopes the instrument has
+  if(ctx->instrument[i][MS_VOLUME] >= 0) {
+    if(decay_rate)
+      emit(ctx, "  decay %i\r\n", decay_rate);
+    emit_text(ctx, "  volume ");
+    write_macro(ctx, &volume);
+    frames = volume.length;
+  }
+  if(duty) {
+    emit_text(ctx, "  timbre ");
+    write_macro(ctx, duty);
+    if(duty->length > frames)
+      frames = duty->length;
+  }
+  if(arp) {
+    if(arp->length > frames)
+      frames = arp->length;
+    emit_text(ctx, "  pitch ");
+
+    if(flags & ABSOLUTE_PITCH) { // Pently sfx pitch envelopes require music notes, not semitone numbers
+      int j;
+      for(j=0; j<arp->length; j++) {
+        if(j == arp->loop)
+          emit_bytes(ctx, "| ", 2);
+        // convert to note
+        int semitones = arp->sequence[j];
+        char note;
+        uint8_t octave;
+        semitone_to_note(semitones, &note, &octave);
+        // print it
+        write_note_name(ctx, note);
+        write_octave(ctx, octave);
+        emit_char(ctx, ' ');
+      }
+      emit_text(ctx, "\r\n");
+    } else {
+      write_macro(ctx, arp);
+    }
+  }
+  return frames;
+}
+
+// converts the number of rows to a Pently note duration
+void write_duration(ft2p_context *ctx, int duration, int slur) {
+  const char *long_duration[] = {
+    /* 1 */ "16",
+    /* 2 */ "8",
+    /* 3 */ "8 w16",
+    /* 4 */ "4",
+    /* 5 */ "4 w16",
+    /* 6 */ "4 w8",
+    /* 7 */ "4 w8 w16",
+    /* 8 */ "2",
+    /* 9 */ "2 w16",
+    /*10 */ "2 w8",
+    /*11 */ "2 w8 w16",
+    /*12 */ "2 w4",
+    /*13 */ "2 w4 w16",
+    /*14 */ "2 w4 w8",
+    /*15 */ "2 w4 w8 w16",
+    /*16 */ "1"
+  };
+  const char *dotted_duration[] = {
+    /* 1 */ "16",
+    /* 2 */ "8",
+    /* 3 */ "8.",
+    /* 4 */ "4",
+    /* 5 */ "4 w16",
+    /* 6 */ "4.",
+    /* 7 */ "4. w16",
+    /* 8 */ "2",
+    /* 9 */ "2 w16",
+    /*10 */ "2 w8",
+    /*11 */ "2 w8.",
+    /*12 */ "2.",
+    /*13 */ "2. w16",
+    /*14 */ "2. w8",
+    /*15 */ "2. w8.",
+    /*16 */ "1"
+  };
+  const char **durations = ctx->options.dotted_durations ? dotted_duration : long_duration;
+
+  duration--;
+  emit_text(ctx, durations[duration%16]);
+  if(slur)
+    emit_char(ctx, '~');
+  emit_char(ctx, ' ');
+  while(duration > 16) {
+    emit_bytes(ctx, "w1 ", 3);
+    duration -= 16;
+  }
+}
+
+// write a time in the format "at" takes
+void write_time(ft2p_context *ctx, int rows) {
+  int measure = rows / 16;
+  int beat    = (rows % 16) / 4;
+  int row     = (rows % 16) % 4;
+
+  emit_int(ctx, measure+1);
+  if(beat || row) {
+    emit_char(ctx, ':');
+    emit_int(ctx, beat+1);
+    emit_char(ctx, ':');
+    emit_int(ctx, row);
+  }
+}
+
+// writes a tempo
+void write_tempo(ft2p_context *ctx, int speed, int tempo) {
+  float real_tempo = 6;
+  real_tempo /= speed;
+  real_tempo *= tempo;
+  emit(ctx, "  tempo %.2f", real_tempo);
+}
+
+// writes the label for a pattern
+static void write_pattern_name(ft2p_context *ctx, const ftlabel *label) {
+  if(ctx->options.short_names) {
+    emit_char(ctx, 'p');
+    emit_int(ctx, label->song_num);
+    emit_char(ctx, 'a'+label->channel);
+    emit_int(ctx, label->id);
+    if(label->row) {
+      emit_char(ctx, 'r');
+      emit_int(ctx, label->row);
+    }
+    return;
+  }
+  emit_bytes(ctx, "pat_", 4);
+  emit_int(ctx, label->song_num);
+  emit_char(ctx, '_');
+  emit_int(ctx, label->channel);
+  emit_char(ctx, '_');
+  emit_int(ctx, label->id);
+  if(label->row) {
+    emit_char(ctx, '_');
+    emit_int(ctx, label->row);
+  }
+}
+
+//////////////////// ca65 output ////////////////////
+// with options.ca65 the same data is written as ca65 source, using the macros and symbols from Pently's
+// pentlyseq.inc, so it can be assembled straight into a game without going through pentlyas
+
+// pattern notes, in semitones above the pattern's transpose
+static const char *const ca65_notes[] = {
+  "N_C",  "N_CS",  "N_D",  "N_DS",  "N_E",  "N_F",  "N_FS",  "N_G",  "N_GS",  "N_A",  "N_AS",  "N_B",
+  "N_CH", "N_CSH", "N_DH", "N_DSH", "N_EH", "N_FH", "N_FSH", "N_GH", "N_GSH", "N_AH", "N_ASH", "N_BH",
+  "N_CHH"
+};
+#define CA65_NOTE_RANGE 24
+
+// the note lengths Pently has, longest first
+static const struct {
+  int rows;
+  const char *name;
+} ca65_durations[] = {{16, "D_1"}, {12, "D_D2"}, {8, "D_2"}, {6, "D_D4"}, {4, "D_4"}, {3, "D_D8"}, {2, "D_8"}, {1, "D_16"}};
+
+// the conductor's name for each channel's track
+static const char *const ca65_tracks[] = {"Sq1", "Sq2", "Tri", "Noise", "Noise", "Attack"};
+
+// Pently pitches count semitones up from A1, which is A-0 in Famitracker
+static inline int pently_pitch(char note, int octave) {
+  return note_to_semitone(note, octave) - 9;
+}
+
+// appends formatted text to one of the tables that are written at the end of the conversion
+static void table_printf(ft2p_context *ctx, int table, const char *fmt, ...) {
+  ft2p_buffer *buffer = &ctx->ca65_table[table];
+  va_list args;
+  va_start(args, fmt);
+  int length = vsnprintf(NULL, 0, fmt, args);
+  va_end(args);
+  if(length <= 0)
+    return;
+  if(buffer->length + length + 1 > buffer->capacity) {
+    size_t capacity = buffer->capacity ? buffer->capacity : 1024;
+    while(capacity < buffer->length + length + 1)
+      capacity *= 2;
+    char *grown = realloc(buffer->data, capacity);
+    if(!grown)
+      error(ctx, 1, "Out of memory");
+    buffer->data = grown;
+    buffer->capacity = capacity;
+  }
+  va_start(args, fmt);
+  vsnprintf(buffer->data + buffer->length, length+1, fmt, args);
+  va_end(args);
+  buffer->length += length;
+}
+
+// writes one byte of a pattern, starting a new .byt line every 8 bytes; returns where its text starts in the output
+static size_t ca65_byte(ft2p_context *ctx, int *count, const char *fmt, ...) {
+  char text[64];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+  emit_text(ctx, (*count)++ % 8 ? ", " : "\r\n  .byt ");
+  size_t start = ctx->out.length;
+  emit_text(ctx, text);
+  return start;
+}
+
+// writes a note, rest or tie lasting some number of rows, followed by as many ties as it takes;
+// returns where the note starts in the output
+static size_t write_ca65_duration(ft2p_context *ctx, int *count, const char *note, int rows) {
+  size_t start = ctx->out.length;
+  for(int i=0, first=1; rows > 0; ) {
+    if(rows < ca65_durations[i].rows) {
+      i++;
+      continue;
+    }
+    size_t at = ca65_byte(ctx, count, "%s|%s", note, ca65_durations[i].name);
+    if(first)
+      start = at;
+    first = 0;
+    rows -= ca65_durations[i].rows;
+    note = "N_TIE";
+  }
+  return start;
+}
+
+// finds the transpose a pitched pattern is played at: the C at or below its lowest note
+static int ca65_pattern_base(const ftnote *pattern, int length) {
+  int lowest = -1;
+  for(int row=0; row<length; row++)
+    if(isalpha(pattern[row].note)) {
+      int pitch = pently_pitch(pattern[row].note, pattern[row].octave);
+      if(lowest < 0 || pitch < lowest)
+        lowest = pitch;
+    }
+  if(lowest < 3) // below the lowest C
+    return lowest < 0 ? 0 : lowest;
+  return lowest - (lowest-3) % NUM_SEMITONES;
+}
+
+// finds the instrument a pattern starts with
+static int pattern_instrument(const ftnote *pattern, int rows) {
+  for(int row=0; row<rows; row++)
+    if(pattern[row].instrument >= 0)
+      return pattern[row].instrument;
+  return -1;
+}
+
+// the value an envelope has on a frame, following its loop once it runs out
+static int envelope_value(const ftmacro *macro, int frame, int otherwise) {
+  if(!macro || !macro->length)
+    return otherwise;
+  if(frame >= macro->length) {
+    if(macro->loop >= 0 && macro->loop < macro->length)
+      frame = macro->loop + (frame - macro->length) % (macro->length - macro->loop);
+    else
+      frame = macro->length-1;
+  }
+  return macro->sequence[frame];
+}
+
+// writes an instrument, or a sound effect if "channel" isn't -1, as the frames of its envelopes and its
+// table entry; instruments keep their last frame as the sustain, and sound effects play every frame
+// returns how many frames long the envelopes are, like write_instrument()
+static int write_ca65_instrument(ft2p_context *ctx, int i, int flags, const char *name, int channel) {
+  ftmacro volume;
+  const ftmacro *duty, *arp;
+  int decay_rate = instrument_envelopes(ctx, i, flags, &volume, &duty, &arp);
+  const ftmacro *volume_envelope = ctx->instrument[i][MS_VOLUME] >= 0 ? &volume : NULL;
+  int frames = volume.length;
+  if(duty && duty->length > frames)
+    frames = duty->length;
+  if(arp && arp->length > frames)
+    frames = arp->length;
+  int envelope_frames = channel >= 0 ? frames : frames-1;
+
+  if(envelope_frames > 0) {
+    emit(ctx, "\r\n%s_%s:", channel >= 0 ? "sfx" : "inst", name);
+    for(int frame=0; frame<envelope_frames; frame++) {
+      int timbre = envelope_value(duty, frame, 2) & 3;
+      int level = envelope_value(volume_envelope, frame, 15) & 15;
+      int pitch = envelope_value(arp, frame, 0);
+      if(channel == CH_NOISE)
+        pitch = (pitch & 15) | (timbre & 1) << 7;
+      else if(flags & ABSOLUTE_PITCH)
+        pitch = arp ? pitch - 9 : 0;
+      emit(ctx, "\r\n  .byt $%02x, %i", timbre << 6 | level, pitch);
+    }
+  }
+
+  if(channel >= 0) {
+    table_printf(ctx, CA65_SFX, "\r\n  sfxdef SFX_%s, sfx_%s, %i, 1, %i", name, name, frames, channel*4);
+  } else {
+    int sustain = frames ? frames-1 : 0;
+    table_printf(ctx, CA65_INSTRUMENTS, "\r\n  instdef PI_%s, %i, %i, %i, 0, ", name,
+                 envelope_value(duty, sustain, 2) & 3, envelope_value(volume_envelope, sustain, 15) & 15, decay_rate);
+    if(envelope_frames > 0)
+      table_printf(ctx, CA65_INSTRUMENTS, "inst_%s, %i", name, envelope_frames);
+    else
+      table_printf(ctx, CA65_INSTRUMENTS, "0, 0");
+  }
+  return frames;
+}
+
+// adds a drum, given as "name sfx" or "name sfx sfx", to the drum table
+static void add_ca65_drum(ft2p_context *ctx, const char *definition) {
+  char words[3][64] = {"", "", ""};
+  int count = sscanf(definition, "%63s %63s %63s", words[0], words[1], words[2]);
+  if(count < 2)
+    error(ctx, 1, "a drum needs a name and one or two sound effects (%s)", definition);
+  table_printf(ctx, CA65_DRUMS, "\r\n  drumdef DR_%s, SFX_%s", words[0], words[1]);
+  if(count == 3)
+    table_printf(ctx, CA65_DRUMS, ", SFX_%s", words[2]);
+}
+
+// the conductor waits until the given row
+static void write_ca65_wait(ft2p_context *ctx, int *now, int row) {
+  while(row > *now) {
+    int rows = row - *now > 255 ? 255 : row - *now;
+    emit(ctx, "\r\n  waitRows %i", rows);
+    *now += rows;
+  }
+}
+
+// writes a tempo for the conductor, in rows per minute (0 for a song that never had its speed set)
+static void write_ca65_tempo(ft2p_context *ctx, int speed, int tempo) {
+  emit(ctx, "\r\n  setTempo %i", speed > 0 ? (tempo*24 + speed/2) / speed : 0);
+}
+
+// writes the tables that point at everything, along with symbols for the songs and patterns
+static void write_ca65_tables(ft2p_context *ctx) {
+  static const char *const table_names[] = {"pently_instruments", "pently_sfx_table", "pently_drums"};
+  for(int i=0; i<CA65_TABLE_COUNT; i++) {
+    emit(ctx, "\r\n\r\n%s:", table_names[i]);
+    if(ctx->ca65_table[i].length)
+      emit_bytes(ctx, ctx->ca65_table[i].data, ctx->ca65_table[i].length);
+  }
+  emit_text(ctx, "\r\n\r\npently_songs:");
+  for(int i=0; i<ctx->num_symbols; i++)
+    if(ctx->symbols[i].kind == SYMBOL_SONG)
+      emit(ctx, "\r\n  .addr song_%s", ctx->symbols[i].name);
+  for(int i=0, song=0; i<ctx->num_symbols; i++)
+    if(ctx->symbols[i].kind == SYMBOL_SONG)
+      emit(ctx, "\r\nSONG_%s = %i", ctx->symbols[i].name, song++);
+
+  // patterns are numbered in the order they were written
+  ft2p_costs *costs = &ctx->costs;
+  char name[64];
+  emit_text(ctx, "\r\n\r\npently_patterns:");
+  for(int i=0; i<costs->num_patterns; i++) {
+    pattern_name(name, sizeof(name), &costs->pattern[i].label, ctx->options.short_names);
+    emit(ctx, "\r\n  .addr %s", name);
+  }
+  for(int i=0; i<costs->num_patterns; i++) {
+    pattern_constant(name, sizeof(name), &costs->pattern[i].label, ctx->options.short_names);
+    emit(ctx, "\r\n%s = %i", name, i);
+  }
+  emit_text(ctx, "\r\n\r\n.export pently_instruments, pently_sfx_table, pently_drums, pently_songs, pently_patterns");
+}
+
+// channels whose patterns can be played on each other
+static int pattern_group(int channel) {
+  switch(channel) {
+    case CH_SQUARE2: case CH_ATTACK:
+      return CH_SQUARE1;
+    case CH_DPCM:
+      return CH_NOISE;
+  }
+  return channel;
+}
+
+#define FNV_PRIME 1099511628211ULL
+
+// FNV-1a hash
+uint64_t ft2p_hash(uint64_t hash, const void *data, size_t length) {
+  const uint8_t *bytes = data;
+  while(length--)
+    hash = (hash ^ *bytes++) * FNV_PRIME;
+  return hash;
+}
+
+// makes a hash table of indexes into "items" (each of which starts with its uint64_t hash) twice as big, or 256 slots
+// to start with, when adding one more item would make it more than half full; empty slots hold -1
+static void grow_hash_index(ft2p_context *ctx, int **index, int *slots, const void *items, int count, size_t item_size) {
+  if(2*(count+1) <= *slots)
+    return;
+  int new_slots = *slots ? *slots*2 : 256;
+  int *new_index = malloc(sizeof(int)*new_slots);
+  if(!new_index)
+    error(ctx, 1, "Out of memory");
+  memset(new_index, 0xff, sizeof(int)*new_slots);
+  for(int i=0; i<count; i++) {
+    uint64_t hash;
+    memcpy(&hash, (const char*)items + item_size*i, sizeof(hash));
+    int slot = hash & (new_slots-1);
+    while(new_index[slot] != -1)
+      slot = (slot+1) & (new_slots-1);
+    new_index[slot] = i;
+  }
+  free(*index);
+  *index = new_index;
+  *slots = new_slots;
+}
+
+// checks if a written pattern has the same text as the two pieces of a new one
+static int same_pattern_text(const ftwritten_pattern *written, char group, const char *part1, size_t length1, const char *part2, size_t length2) {
+  return written->length == 1+length1+length2 && written->text[0] == group
+      && !memcmp(written->text+1, part1, length1) && !memcmp(written->text+1+length1, part2, length2);
+}
+
+// looks up a pattern's text (made of two pieces) in the patterns that were already written;
+// returns the one with the same text if there is one, or remembers this one and returns NULL
+static ftwritten_pattern *find_written_pattern(ft2p_context *ctx, char group, const char *part1, size_t length1, const char *part2, size_t length2,
+                                               const ftlabel *label, int base) {
+  uint64_t hash = ft2p_hash(ft2p_hash(ft2p_hash(FT2P_HASH_START, &group, 1), part1, length1), part2, length2);
+
+  grow_hash_index(ctx, &ctx->written_pattern_index, &ctx->written_pattern_slots, ctx->written_patterns,
+                  ctx->num_written_patterns, sizeof(ftwritten_pattern));
+
+  int slot = hash & (ctx->written_pattern_slots-1);
+  for(; ctx->written_pattern_index[slot] != -1; slot = (slot+1) & (ctx->written_pattern_slots-1)) {
+    ftwritten_pattern *written = &ctx->written_patterns[ctx->written_pattern_index[slot]];
+    if(written->hash == hash && same_pattern_text(written, group, part1, length1, part2, length2))
+      return written;
+  }
+
+  ctx->written_patterns = grow_array(ctx, ctx->written_patterns, &ctx->written_patterns_allocated, ctx->num_written_patterns+1, sizeof(ftwritten_pattern));
+  char *text = malloc(1+length1+length2);
+  if(!text)
+    error(ctx, 1, "Out of memory");
+  text[0] = group;
+  memcpy(text+1, part1, length1);
+  memcpy(text+1+length1, part2, length2);
+  ftwritten_pattern *written = &ctx->written_patterns[ctx->num_written_patterns];
+  written->hash = hash;
+  written->text = text;
+  written->length = 1+length1+length2;
+  written->label = *label;
+  written->base = base;
+  ctx->written_pattern_index[slot] = ctx->num_written_patterns++;
+  return NULL;
+}
+
+// takes the pattern that was just written back out of the output, and points its label at another one instead
+static void use_written_pattern(ft2p_context *ctx, ftlabel *label, const ftwritten_pattern *written, size_t start, int transpose) {
+  *label = written->label;
+  label->transpose = transpose;
+  ctx->patterns_shared++;
+  if(transpose)
+    ctx->patterns_transposed++;
+  ctx->pattern_bytes_saved += ctx->out.length - start;
+  ctx->out.length = start;
+  while(ctx->num_drum_refs && ctx->drum_refs[ctx->num_drum_refs-1].offset >= start)
+    ctx->num_drum_refs--;
+}
+
+// looks for an identical pattern that was already written, and uses it instead of the one that was just written
+// "start" is where the pattern begins in the output, "key" is right after its name, and "skip" to "skip_end"
+// is the part that says which channel it's on, which doesn't matter as long as the channels can share patterns
+static void share_pattern(ft2p_context *ctx, ftlabel *label, size_t start, size_t key, size_t skip, size_t skip_end) {
+  const char *out = ctx->out.data;
+  ftwritten_pattern *written = find_written_pattern(ctx, pattern_group(label->channel), out+key, skip-key, out+skip_end, ctx->out.length-skip_end, label, 0);
+  if(written)
+    use_written_pattern(ctx, label, written, start, 0);
+}
+
+// looks for a pattern that was already written that's the same as the one that was just written except for being
+// a constant number of semitones higher or lower, and plays that one transposed instead
+// returns 0 if the pattern has notes that can't be transposed
+static int share_transposed_pattern(ft2p_context *ctx, ftlabel *label, const ftnote *pattern, int length, size_t start) {
+  // find the pitch everything is relative to
+  int base = -1;
+  for(int row=0; row<length && base == -1; row++)
+    if(isalpha(pattern[row].note)) {
+      if(!strchr(scale, pattern[row].note))
+        return 0;
+      base = note_to_semitone(pattern[row].note, pattern[row].octave);
+    }
+
+  // key on what's written for each row, with pitches made relative to the first note; fields that aren't written
+  // are left out, since rows that weren't exported and rows exported as blank don't hold the same instrument
+  enum {ROW_KEY = 5 + 2*MAX_EFFECTS};
+  uint8_t *key = calloc(length ? length : 1, ROW_KEY);
+  if(!key)
+    error(ctx, 1, "Out of memory");
+  for(int row=0; row<length; row++) {
+    const ftnote *note = &pattern[row];
+    uint8_t *k = key + ROW_KEY*row;
+    k[0] = note->note;
+    if(isalpha(note->note)) {
+      if(!strchr(scale, note->note)) {
+        free(key);
+        return 0;
+      }
+      k[0] = 'n';
+      k[1] = note_to_semitone(note->note, note->octave) - base;
+      k[2] = note->instrument;
+      k[3] = note->instrument >> 8;
+    }
+    k[4] = note->volume | (note->slur ? 0x80 : 0);
+    for(int i=0; i<MAX_EFFECTS; i++)
+      if(note->effect[i] && note->effect[i] != '.') {
+        k[5+2*i] = note->effect[i];
+        k[6+2*i] = note->param[i];
+      }
+  }
+  ftwritten_pattern *written = find_written_pattern(ctx, 0x80 | pattern_group(label->channel), (char*)key, ROW_KEY*length, "", 0, label, base);
+  free(key);
+  if(written)
+    use_written_pattern(ctx, label, written, start, base - written->base);
+  return 1;
+}
+
+// checks if two envelopes would be written the same way
+static int same_macro(const ftmacro *a, const ftmacro *b) {
+  return a->length == b->length && a->loop == b->loop && a->release == b->release
+      && a->decay_rate == b->decay_rate && a->decay_volume == b->decay_volume && a->decay_index == b->decay_index
+      && !memcmp(a->sequence, b->sequence, a->length);
+}
+
+// something to be interned, sorted by its hash so that identical ones end up next to each other
+typedef struct ftintern {
+  uint64_t hash;
+  int id;
+} ftintern;
+
+static int compare_interns(const void *a, const void *b) {
+  const ftintern *x = a, *y = b;
+  if(x->hash != y->hash)
+    return x->hash < y->hash ? -1 : 1;
+  return x->id - y->id;
+}
+
+// finds instruments with identical envelopes (even if they're stored under different macro numbers)
+// and makes notes use the first one, so that the rest don't need to be written
+static void merge_instruments(ft2p_context *ctx) {
+  int count = ctx->num_instruments;
+  if(!count)
+    return;
+  int *same[MACRO_SET_COUNT] = {NULL};
+  ftintern *interns = NULL;
+  int most = count, set, i, j;
+  for(set=0; set<MACRO_SET_COUNT; set++)
+    if(ctx->num_macros[set] > most)
+      most = ctx->num_macros[set];
+  interns = malloc(sizeof(ftintern)*most);
+  if(!interns)
+    error(ctx, 1, "Out of memory");
+
+  // intern each kind of envelope; same[set][id] is the first macro that's identical to that one
+  for(set=0; set<MACRO_SET_COUNT; set++) {
+    int macros = ctx->num_macros[set];
+    same[set] = malloc(sizeof(int) * (macros ? macros : 1));
+    if(!same[set]) {
+      for(i=0; i<set; i++)
+        free(same[i]);
+      free(interns);
+      error(ctx, 1, "Out of memory");
+    }
+    for(i=0; i<macros; i++) {
+      ftmacro *macro = &ctx->instrument_macro[set][i];
+      int16_t shape[3] = {macro->length, macro->loop, macro->release};
+      interns[i].hash = ft2p_hash(ft2p_hash(FT2P_HASH_START, shape, sizeof(shape)), macro->sequence, macro->length);
+      interns[i].id = i;
+    }
+    qsort(interns, macros, sizeof(ftintern), compare_interns);
+    for(i=0; i<macros; i++) {
+      ftmacro *macro = &ctx->instrument_macro[set][interns[i].id];
+      same[set][interns[i].id] = interns[i].id;
+      for(j=i-1; j>=0 && interns[j].hash == interns[i].hash; j--)
+        if(same_macro(&ctx->instrument_macro[set][interns[j].id], macro)) {
+          same[set][interns[i].id] = same[set][interns[j].id];
+          break;
+        }
+    }
+  }
+
+  // then intern instruments by the envelopes they use
+  int key[MACRO_SET_COUNT+1];
+  for(i=0; i<count; i++) {
+    for(set=0; set<MACRO_SET_COUNT; set++)
+      key[set] = ctx->instrument[i][set] >= 0 ? same[set][ctx->instrument[i][set]] : -1;
+    key[MACRO_SET_COUNT] = ctx->instrument_ignore[i];
+    interns[i].hash = ft2p_hash(FT2P_HASH_START, key, sizeof(key));
+    interns[i].id = i;
+  }
+  qsort(interns, count, sizeof(ftintern), compare_interns);
+  for(i=0; i<count; i++) {
+    int id = interns[i].id;
+    if(!*ctx->instrument_name[id]) // never defined
+      continue;
+    for(j=i-1; j>=0 && interns[j].hash == interns[i].hash; j--) {
+      int other = interns[j].id;
+      if(!*ctx->instrument_name[other] || ctx->instrument_ignore[other] != ctx->instrument_ignore[id])
+        continue;
+      for(set=0; set<MACRO_SET_COUNT; set++)
+        if((ctx->instrument[id][set] >= 0 ? same[set][ctx->instrument[id][set]] : -1)
+        != (ctx->instrument[other][set] >= 0 ? same[set][ctx->instrument[other][set]] : -1))
+          break;
+      if(set == MACRO_SET_COUNT) {
+        ctx->instrument_alias[id] = ctx->instrument_alias[other];
+        ctx->instruments_merged++;
+        log_printf(ctx, "merged instrument %s into %s\n", ctx->instrument_name[id], ctx->instrument_name[ctx->instrument_alias[id]]);
+        break;
+      }
+    }
+  }
+
+  for(set=0; set<MACRO_SET_COUNT; set++)
+    free(same[set]);
+  free(interns);
+}
+
+//////////////////// symbols ////////////////////
+
+// finds the slot in the symbol index that holds a name of some kind, or the empty slot it would go in
+static int symbol_slot(const ft2p_context *ctx, int kind, const char *name, uint64_t hash) {
+  int slot = hash & (ctx->symbol_slots-1);
+  for(; ctx->symbol_index[slot] != -1; slot = (slot+1) & (ctx->symbol_slots-1)) {
+    const ftsymbol *symbol = &ctx->symbols[ctx->symbol_index[slot]];
+    if(symbol->hash == hash && symbol->kind == kind && !strcmp(symbol->name, name))
+      break;
+  }
+  return slot;
+}
+
+static uint64_t symbol_hash(int kind, const char *name) {
+  uint8_t k = kind;
+  return ft2p_hash(ft2p_hash(FT2P_HASH_START, &k, 1), name, strlen(name));
+}
+
+// looks up a name of some kind that the output defines; returns it if it was already defined, or else defines it
+// (standing for "long_name" with short_names, unless that's NULL) and returns NULL
+static const ftsymbol *intern_symbol(ft2p_context *ctx, int kind, const char *name, const char *long_name) {
+  uint64_t hash = symbol_hash(kind, name);
+
+  grow_hash_index(ctx, &ctx->symbol_index, &ctx->symbol_slots, ctx->symbols, ctx->num_symbols, sizeof(ftsymbol));
+
+  int slot = symbol_slot(ctx, kind, name, hash);
+  if(ctx->symbol_index[slot] != -1)
+    return &ctx->symbols[ctx->symbol_index[slot]];
+  ctx->symbols = grow_array(ctx, ctx->symbols, &ctx->symbols_allocated, ctx->num_symbols+1, sizeof(ftsymbol));
+  ftsymbol *symbol = &ctx->symbols[ctx->num_symbols];
+  symbol->hash = hash;
+  symbol->kind = kind;
+  strlcpy(symbol->name, name, sizeof(symbol->name));
+  strlcpy(symbol->long_name, long_name && strcmp(long_name, name) ? long_name : "", sizeof(symbol->long_name));
+  ctx->symbol_index[slot] = ctx->num_symbols++;
+  return NULL;
+}
+
+// the name something defined under "name" would have had without short_names
+static const char *long_symbol_name(const ft2p_context *ctx, int kind, const char *name) {
+  if(!ctx->symbol_slots)
+    return name;
+  int index = ctx->symbol_index[symbol_slot(ctx, kind, name, symbol_hash(kind, name))];
+  return index != -1 && *ctx->symbols[index].long_name ? ctx->symbols[index].long_name : name;
+}
+
+// the name an automatic dual drum is written under
+static void auto_drum_name(const ft2p_context *ctx, char *name, size_t size, int drum) {
+  snprintf(name, size, ctx->options.short_names ? "d%i_" : "autodrum%i_", drum);
+}
+
+// defines the names of the patterns that were written, once every song has been; export jobs don't touch the
+// symbols, so their patterns are only defined once they've been merged
+static void intern_pattern_names(ft2p_context *ctx) {
+  for(int i=0; i<ctx->costs.num_patterns; i++) {
+    char name[64], long_name[64];
+    pattern_name(name, sizeof(name), &ctx->costs.pattern[i].label, ctx->options.short_names);
+    pattern_name(long_name, sizeof(long_name), &ctx->costs.pattern[i].label, 0);
+    if(intern_symbol(ctx, SYMBOL_PATTERN, name, long_name))
+      error(ctx, 1, "Pattern %s was written twice", name);
+  }
+}
+
+// tells ctx->map what each short name stands for
+static void write_symbol_map(ft2p_context *ctx) {
+  if(!ctx->options.short_names || !ctx->map.write)
+    return;
+  for(int i=0; i<ctx->num_symbols; i++)
+    if(*ctx->symbols[i].long_name)
+      sink_printf(&ctx->map, "%s %s\n", ctx->symbols[i].name, ctx->symbols[i].long_name);
+}
+
+//////////////////// pattern factoring ////////////////////
+// with factor_patterns, runs of rows that show up in more than one place in a song (like a fill or a phrase that
+// comes back) are split off into patterns of their own that are only written once, and the conductor plays each
+// piece of a split pattern when its first row comes up
+
+#define MIN_PIECE_ROWS 4
+
+// a run of rows that could be split off: a pattern's half, quarter, eighth and so on
+typedef struct ftblock {
+  uint64_t hash;
+  int channel, id, row, rows, instrument, bytes;
+  int same;  // first block with the same rows
+  int taken; // 1 if it was split off, 2 if it's played from another block instead of being written
+} ftblock;
+
+// returns the piece of a split pattern that starts at a row, or NULL
+static ftpiece *piece_at(ftsong *xsong, int id, int channel, int row) {
+  ftpattern *p = xsong->pattern[id];
+  for(int i=0; i<p->pieces[channel]; i++)
+    if(p->piece[channel][i].row == row)
+      return &p->piece[channel][i];
+  return NULL;
+}
+
+// checks if a row has any effects at all
+static int has_effects(const ftnote *note) {
+  for(int i=0; i<MAX_EFFECTS; i++)
+    if(note->effect[i] && note->effect[i] != '.')
+      return 1;
+  return 0;
+}
+
+// finds the rows a pattern can be split at without changing how it plays, and the instrument a piece starting at
+// each row would start with; a split can't happen while something is slurring, and a split on a row without a note
+// or volume change (which continues the note before it, like a frame change does) can't have effects on that row
+static void find_split_rows(const ftnote *pattern, int length, int instrument, uint8_t *can_split, int *instrument_at) {
+  int slur = 0, delay_cut = 0;
+  memset(can_split, 0, length);
+  can_split[0] = 1;
+  for(int row=0; row<length; ) {
+    int next;
+    for(next = row+1; next < length; next++)
+      if(pattern[next].note || pattern[next].volume)
+        break;
+    if(isalnum(pattern[row].note) && pattern[row].instrument >= 0)
+      instrument = pattern[row].instrument;
+    for(int i=0; i<MAX_EFFECTS; i++)
+      if(pattern[row].effect[i] == FX_SLUR)
+        slur = pattern[row].param[i] != 0;
+      else if(pattern[row].effect[i] == FX_DELAYCUT && pattern[row].note)
+        delay_cut = 1;
+    if(isalpha(pattern[row].note))
+      delay_cut = 0;
+    int clean = !slur && !pattern[row].slur && !delay_cut;
+    instrument_at[row] = instrument;
+    for(int i=row+1; i<next; i++) {
+      instrument_at[i] = instrument;
+      can_split[i] = clean && !has_effects(&pattern[i]);
+    }
+    if(next < length)
+      can_split[next] = clean;
+    row = next;
+  }
+}
+
+// estimates the bytes a run of rows takes, the same way write_rows does
+static int estimate_rows(const ftnote *pattern, int length, int instrument, int pitched) {
+  int bytes = 0, slur = 0, legato = 0;
+  for(int row=0; row<length; ) {
+    int next;
+    for(next = row+1; next < length; next++)
+      if(pattern[next].note || pattern[next].volume)
+        break;
+    if(isalnum(pattern[row].note) && pattern[row].instrument >= 0 && pattern[row].instrument != instrument) {
+      instrument = pattern[row].instrument;
+      bytes += pitched ? 2 : 0;
+    }
+    if(pattern[row].volume)
+      bytes += 2;
+    for(int i=0; i<MAX_EFFECTS; i++)
+      switch(pattern[row].effect[i]) {
+        case FX_SLUR:
+          slur = pattern[row].param[i] != 0;
+          break;
+        case FX_ARP: case FX_VIBRATO:
+          bytes += pitched ? 2 : 0;
+          break;
+        case FX_DELAY: case FX_DELAYCUT:
+          bytes += 2+1;
+          break;
+      }
+    bytes += duration_bytes(next-row);
+    if(legato != (slur|pattern[row].slur)) {
+      legato = slur|pattern[row].slur;
+      bytes++;
+    }
+    row = next;
+  }
+  return bytes;
+}
+
+static int compare_blocks(const void *a, const void *b) {
+  const ftblock *x = a, *y = b;
+  if(x->hash != y->hash)
+    return x->hash < y->hash ? -1 : 1;
+  if(x->channel != y->channel)
+    return x->channel - y->channel;
+  if(x->id != y->id)
+    return x->id - y->id;
+  return x->row - y->row;
+}
+
+static int same_block(ftsong *xsong, const ftblock *a, const ftblock *b) {
+  return a->hash == b->hash && a->rows == b->rows && a->instrument == b->instrument
+      && pattern_group(a->channel) == pattern_group(b->channel)
+      && !memcmp(get_pattern(xsong, a->id, a->channel) + a->row, get_pattern(xsong, b->id, b->channel) + b->row, sizeof(ftnote)*a->rows);
+}
+
+// checks if a note or volume change starts on a row of a block's pattern
+static int pattern_row_starts(ftsong *xsong, const ftblock *block, int row) {
+  const ftnote *note = get_pattern(xsong, block->id, block->channel) + row;
+  return note->note || note->volume;
+}
+
+// checks if a pattern will already be split at a row, because of a block that was already split off
+static int split_at(const ftblock *blocks, int count, int channel, int id, int row) {
+  for(int i=0; i<count; i++)
+    if(blocks[i].taken && blocks[i].channel == channel && blocks[i].id == id
+       && (blocks[i].row == row || blocks[i].row + blocks[i].rows == row))
+      return 1;
+  return 0;
+}
+
+// checks if a block overlaps one that was already split off
+static int overlaps_taken(const ftblock *blocks, int count, const ftblock *block) {
+  for(int i=0; i<count; i++)
+    if(blocks[i].taken && blocks[i].channel == block->channel && blocks[i].id == block->id
+       && blocks[i].row < block->row + block->rows && block->row < blocks[i].row + blocks[i].rows)
+      return 1;
+  return 0;
+}
+
+// sorts candidates by the bytes they'd save, biggest first, and then by where they are
+static int compare_candidates(const void *a, const void *b) {
+  const int *x = a, *y = b;
+  if(x[1] != y[1])
+    return y[1] - x[1];
+  return x[0] - y[0];
+}
+
+// decides which runs of rows in a song get split off, and splits the patterns they're in into pieces;
+// has to be done after the song's used patterns are known and before any of them are written
+static void factor_song(ft2p_context *ctx, ftsong *xsong) {
+  int drums_on_noise = ctx->options.auto_noise || ctx->options.auto_dual_drums;
+  int num_blocks = 0, blocks_allocated = 0;
+  ftblock *blocks = NULL;
+  uint8_t can_split[MAX_ROWS+1];
+  int instrument_at[MAX_ROWS+1];
+
+  // splitting a pattern costs a "play" and a wait every time a frame plays it
+  int *plays = calloc(xsong->patterns_allocated ? xsong->patterns_allocated : 1, sizeof(int[CHANNEL_COUNT]));
+  if(!plays)
+    error(ctx, 1, "Out of memory");
+  for(int i=0; i<xsong->frames; i++)
+    for(int j=0; j<CHANNEL_COUNT; j++)
+      if(get_pattern_used(xsong, xsong->frame[i][j], j))
+        plays[xsong->frame[i][j]*CHANNEL_COUNT + j]++;
+
+  // find every block that could be split off
+  for(int j=0; j<CHANNEL_COUNT; j++) {
+    if((j == CH_NOISE && !drums_on_noise) || (j == CH_DPCM && drums_on_noise))
+      continue;
+    for(int id=0; id<xsong->patterns_allocated; id++) {
+      if(!get_pattern_used(xsong, id, j))
+        continue;
+      const ftnote *pattern = get_pattern(xsong, id, j);
+      int length = get_pattern_length(xsong, id, j), instrument = pattern_instrument(pattern, xsong->rows);
+      if(instrument == -1)
+        continue; // write_pattern will complain about it
+      find_split_rows(pattern, length, instrument, can_split, instrument_at);
+      can_split[length] = 1;
+      for(int rows = xsong->rows/2; rows >= MIN_PIECE_ROWS; rows /= 2)
+        for(int row = 0; row+rows <= length; row += rows) {
+          if(!can_split[row] || !can_split[row+rows])
+            continue;
+          blocks = grow_array(ctx, blocks, &blocks_allocated, num_blocks+1, sizeof(ftblock));
+          ftblock *block = &blocks[num_blocks++];
+          char group = pattern_group(j);
+          block->hash = ft2p_hash(ft2p_hash(ft2p_hash(ft2p_hash(FT2P_HASH_START, &group, 1), &rows, sizeof(rows)),
+                                   &instrument_at[row], sizeof(int)), pattern+row, sizeof(ftnote)*rows);
+          block->channel = j;
+          block->id = id;
+          block->row = row;
+          block->rows = rows;
+          block->instrument = instrument_at[row];
+          block->bytes = estimate_rows(pattern+row, rows, instrument_at[row], channel_is_pitched(j));
+        }
+    }
+  }
+
+  // identical blocks end up next to each other, in the order they're written in
+  if(num_blocks)
+    qsort(blocks, num_blocks, sizeof(ftblock), compare_blocks);
+  int num_candidates = 0, *candidates = malloc(sizeof(int[2]) * (num_blocks ? num_blocks : 1));
+  if(!candidates)
+    error(ctx, 1, "Out of memory");
+  for(int i=0; i<num_blocks; i++) {
+    blocks[i].same = i;
+    for(int k=i-1; k>=0 && blocks[k].hash == blocks[i].hash; k--)
+      if(blocks[k].same == k && same_block(xsong, &blocks[k], &blocks[i])) {
+        blocks[i].same = k;
+        break;
+      }
+    if(blocks[i].same == i) {
+      candidates[2*num_candidates] = i;
+      num_candidates++;
+    }
+  }
+  // first guess at how much each one saves, to decide which to try first
+  for(int c=0; c<num_candidates; c++) {
+    int first = candidates[2*c], copies = 0;
+    for(int i=first; i<num_blocks && blocks[i].hash == blocks[first].hash; i++)
+      copies += blocks[i].same == first;
+    candidates[2*c+1] = (copies-1) * blocks[first].bytes;
+  }
+  qsort(candidates, num_candidates, sizeof(int[2]), compare_candidates);
+
+  // split off each block that's worth it, skipping copies that overlap blocks that were already split off
+  for(int c=0; c<num_candidates && candidates[2*c+1] > 0; c++) {
+    int first = candidates[2*c], copies = 0, cost = 0, owner = -1;
+    for(int i=first; i<num_blocks && blocks[i].hash == blocks[first].hash; i++) {
+      ftblock *block = &blocks[i];
+      if(block->same != first || overlaps_taken(blocks, num_blocks, block))
+        continue;
+      // each new place a pattern is split at makes another pattern and another "play"
+      // (and a split on a row without a note splits the note before it in two)
+      int length = get_pattern_length(xsong, block->id, block->channel);
+      for(int row = block->row; row <= block->row + block->rows; row += block->rows)
+        if(row && row < length && !split_at(blocks, num_blocks, block->channel, block->id, row))
+          cost += 2+1 + (4+2) * plays[block->id*CHANNEL_COUNT + block->channel] + !pattern_row_starts(xsong, block, row);
+      block->taken = owner == -1 ? 1 : 2;
+      if(owner == -1)
+        owner = i;
+      copies++;
+    }
+    int saved = (copies-1) * blocks[first].bytes - cost;
+    if(copies < 2 || saved <= 0) { // not worth it after all
+      for(int i=first; i<num_blocks && blocks[i].hash == blocks[first].hash; i++)
+        if(blocks[i].same == first)
+          blocks[i].taken = 0;
+      continue;
+    }
+    for(int i=first; i<num_blocks && blocks[i].hash == blocks[first].hash; i++)
+      if(blocks[i].same == first)
+        blocks[i].same = owner; // so the copies can find the one that's written
+    ctx->pieces_factored++;
+    ctx->pieces_shared += copies-1;
+    ctx->factor_bytes_saved += saved;
+  }
+  free(candidates);
+  free(plays);
+
+  // split up the patterns, in the order their blocks were found
+  for(int i=0; i<num_blocks; i++) {
+    if(!blocks[i].taken)
+      continue;
+    ftpattern *p = xsong->pattern[blocks[i].id];
+    int j = blocks[i].channel;
+    if(p->pieces[j])
+      continue;
+    const ftnote *pattern = p->row[j];
+    int length = get_pattern_length(xsong, blocks[i].id, j);
+    find_split_rows(pattern, length, pattern_instrument(pattern, xsong->rows), can_split, instrument_at);
+    memset(can_split, 0, sizeof(can_split)); // now marks where the pattern is actually split
+    can_split[0] = 1;
+    for(int k=0; k<num_blocks; k++)
+      if(blocks[k].taken && blocks[k].channel == j && blocks[k].id == blocks[i].id) {
+        can_split[blocks[k].row] = 1;
+        can_split[blocks[k].row + blocks[k].rows] = 1;
+      }
+    p->piece[j] = malloc(sizeof(ftpiece) * length);
+    if(!p->piece[j])
+      error(ctx, 1, "Out of memory");
+    for(int row=0; row<length; row++) {
+      if(!can_split[row])
+        continue;
+      ftpiece *piece = &p->piece[j][p->pieces[j]++];
+      memset(piece, 0, sizeof(ftpiece));
+      piece->row = row;
+      piece->instrument = instrument_at[row];
+      piece->from_id = -1;
+      for(int k=0; k<num_blocks; k++)
+        if(blocks[k].taken == 2 && blocks[k].channel == j && blocks[k].id == blocks[i].id && blocks[k].row == row) {
+          const ftblock *owner = &blocks[blocks[k].same];
+          piece->from_id = owner->id;
+          piece->from_channel = owner->channel;
+          piece->from_row = owner->row;
+        }
+    }
+  }
+  free(blocks);
+}
+
+// writes "length" rows of a pattern starting at "first", under the name in "label", starting with "instrument"
+static void write_rows(ft2p_context *ctx, ftsong *xsong, ftlabel *label, int first, int length, int instrument) {
+  int auto_dual_drums = ctx->options.auto_dual_drums;
+  int channel = label->channel;
+  ftlabel own = *label;
+  ftpattern *p = xsong->pattern[label->id];
+  ftnote *pattern = p->row[channel] + first;
+  const ftevent *events = p->event[channel];
+  int event = find_event(p, channel, first);
+  int i, slur = 0, delay_cut = 0;
+  int bytes = 2+1, legato = 0; // estimated size, starting with the pattern's pointer and its end marker
+
+  // generate pattern name and specify absolute octaves
+  // (ca65 patterns are a label and then bytes, with notes counted from the transpose the conductor plays them at)
+  int ca65 = ctx->options.ca65, count = 0, base = 0, transposed = 0;
+  size_t start = ctx->out.length;
+  emit_text(ctx, ca65 ? "\r\n" : "\r\n  pattern ");
+  write_pattern_name(ctx, label);
+  size_t key = ctx->out.length, skip = key, skip_end = key;
+  if(ca65) {
+    emit_char(ctx, ':');
+    if(channel_is_pitched(channel))
+      base = ca65_pattern_base(pattern, length);
+  } else {
+    if(channel_is_pitched(channel)) {
+      emit(ctx, " with %s", ctx->instrument_name[instrument]);
+      skip = ctx->out.length;
+      emit(ctx, " on %s", chan_name[channel]);
+      skip_end = ctx->out.length;
+      emit_text(ctx, "\r\n    absolute");
+    }
+    emit_text(ctx, "\r\n    ");
+  }
+
+  // for each row
+  int row = 0;
+  while(row < length) {
+    char this_note = pattern[row].note;
+    int next, octave = pattern[row].octave;
+
+    // find the next note
+    while(event < p->events[channel] && (events[event].row <= first+row || !(events[event].flags & (EVENT_NOTE|EVENT_VOLUME))))
+      event++;
+    next = event < p->events[channel] && events[event].row < first+length ? events[event].row - first : length;
+    // the distance between this note and the next note is the duration
+    int duration = next-row;
+
+    // write any instrument changes
+    if(isalnum(this_note) && pattern[row].instrument >= 0 && pattern[row].instrument != instrument) {
+      instrument = pattern[row].instrument;
+      if(channel_is_pitched(channel) && ca65) {
+        ca65_byte(ctx, &count, "INSTRUMENT");
+        ca65_byte(ctx, &count, "PI_%s", ctx->instrument_name[instrument]);
+        bytes += 2;
+      } else if(channel_is_pitched(channel))
+      {
+        emit_char(ctx, '@');
+        emit_text(ctx, ctx->instrument_name[instrument]);
+        emit_char(ctx, ' ');
+        bytes += 2;
+      }
+    }
+
+    // write volume changes
+    if(pattern[row].volume && ca65) {
+      bytes += 2;
+      ca65_byte(ctx, &count, "CHVOLUME");
+      ca65_byte(ctx, &count, "%i", 5 - pattern[row].volume); // 1 for pp up to 4 for ff
+    } else if(pattern[row].volume) {
+      bytes += 2;
+      switch(pattern[row].volume) {
+        case VOL_FF:
+          emit_bytes(ctx, "ff ", 3);
+          break;
+        case VOL_MF:
+          emit_bytes(ctx, "mf ", 3);
+          break;
+        case VOL_MP:
+          emit_bytes(ctx, "mp ", 3);
+          break;
+        case VOL_PP:
+          emit_bytes(ctx, "pp ", 3);
+          break;
+      }
+    }
+
+    // handle any effects
+    for(i=0; i<MAX_EFFECTS; i++) {
+      switch(pattern[row].effect[i]) {
+        case FX_SLUR:
+          slur = pattern[row].param[i] != 0;
+          break;
+        case FX_ARP:
+          if(channel_is_pitched(channel) && ca65) {
+            ca65_byte(ctx, &count, "ARPEGGIO");
+            ca65_byte(ctx, &count, "$%02x", pattern[row].param[i]);
+            bytes += 2;
+          } else if(channel_is_pitched(channel))
+          {
+            emit_bytes(ctx, "EN", 2);
+            emit_hex2(ctx, pattern[row].param[i]);
+            emit_char(ctx, ' ');
+            bytes += 2;
+          }
+          break;
+        case FX_VIBRATO:
+          if(channel_is_pitched(channel) && ca65) {
+            static const int depths[16] = {0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4};
+            bytes += 2;
+            ca65_byte(ctx, &count, "VIBRATO");
+            ca65_byte(ctx, &count, "%i", depths[pattern[row].param[i] & 15]);
+          } else if(channel_is_pitched(channel)) {
+            bytes += 2;
+            switch(pattern[row].param[i] & 15) {
+              case 0:
+                emit_bytes(ctx, "MP0 ", 4);
+                break;
+              case 1: case 2:
+                emit_bytes(ctx, "MP1 ", 4);
+                break;
+              case 3: case 4:
+                emit_bytes(ctx, "MP2 ", 4);
+                break;
+              case 5: case 6:
+                emit_bytes(ctx, "MP3 ", 4);
+                break;
+              default:
+                emit_bytes(ctx, "MP4 ", 4);
+                break;
+            }
+          }
+          break;
+        case FX_DELAYCUT:
+          if(this_note) {
+            delay_cut = pattern[row].param[i];
+            break;
+          }
+          // if it's an empty row, turn it into a delay and insert a note cut right here instead of at the next note
+          pattern[row].note = '-';
+        case FX_DELAY:
+          if(ca65) {
+            ca65_byte(ctx, &count, "GRACE");
+            ca65_byte(ctx, &count, "%i", pattern[row].param[i]);
+            ca65_byte(ctx, &count, "REST");
+          } else {
+            emit_char(ctx, 'r');
+            emit_int(ctx, pattern[row].param[i]);
+            emit_bytes(ctx, "g ", 2);
+          }
+          bytes += 2+1;
+          break;
+      }
+    }
+
+    // drums are named after the drum they play
+    char drum[80] = "";
+    int auto_drum = 0; // 1 if it's played from noise, and might be renamed
+    if(!this_note || this_note == '-' || channel_is_pitched(channel)) {
+      // not a drum
+    } else if(channel == CH_NOISE) { // noise
+      if(auto_dual_drums) { // auto_dual_drums
+        int noise = instrument;
+        uint8_t triangle = 255; // default to no triangle part
+        if(pattern[row].effect[0] == FX_ATTACK_ON) { // repurposed effect
+          triangle = pattern[row].param[0];
+        }
+        auto_drum_name(ctx, drum, sizeof(drum), find_auto_drum(ctx, noise, triangle));
+      } else { // auto_noise
+        // for noise, use the instrument name and the note frequency
+
+        // mark frequency as being used
+        char hex[2] = {this_note, 0};
+        ctx->instrument_noise[instrument] |= 1 << strtol(hex, NULL, 16);
+
+        snprintf(drum, sizeof(drum), "%s_%c_", ctx->instrument_name[instrument], tolower(this_note));
+      }
+      auto_drum = 1;
+    } else { // DPCM
+      // for DPCM: write drum name
+      char *scale_note = strchr(scale, this_note);
+      snprintf(drum, sizeof(drum), "%s", ctx->drum_name[octave][scale_note-scale]);
+    }
+
+    if(ca65) {
+      char note[96];
+      if(this_note == '-') { // note cut
+        strcpy(note, "REST");
+      } else if(!this_note) { // no note
+        strcpy(note, "N_TIE");
+      } else if(channel_is_pitched(channel)) {
+        // move the pattern's transpose if the note is out of its range
+        int pitch = pently_pitch(this_note, octave);
+        if(pitch < base || pitch > base+CA65_NOTE_RANGE) {
+          int new_base = pitch < base ? pitch : pitch-CA65_NOTE_RANGE;
+          ca65_byte(ctx, &count, "TRANSPOSE");
+          ca65_byte(ctx, &count, "%i", new_base-base);
+          transposed += new_base-base;
+          base = new_base;
+          bytes += 2;
+        }
+        strcpy(note, ca65_notes[pitch-base]);
+      } else {
+        snprintf(note, sizeof(note), "DR_%s", drum);
+      }
+      if(delay_cut && isalpha(this_note)) {
+        ca65_byte(ctx, &count, "GRACE");
+        ca65_byte(ctx, &count, "%i", delay_cut);
+        size_t at = ca65_byte(ctx, &count, "%s", note);
+        if(auto_drum)
+          add_drum_ref(ctx, at+3, drum); // after "DR_"
+        auto_drum = 0;
+        strcpy(note, "REST");
+        delay_cut = 0;
+        bytes += 2+1;
+      }
+      size_t at = write_ca65_duration(ctx, &count, note, duration);
+      if(auto_drum)
+        add_drum_ref(ctx, at+3, drum);
+    } else {
+      // write note
+      if(this_note == '-') { // note cut
+          emit_char(ctx, 'r');
+      } else if(!this_note) { // no not
+          emit_char(ctx, 'w');
+      } else if(channel_is_pitched(channel)) { // a note
+        // just write normal notes
+        write_note_name(ctx, this_note);
+
+        // shift the octave in the direction needed
+        write_octave(ctx, octave);
+      } else {
+        if(auto_drum)
+          add_drum_ref(ctx, ctx->out.length, drum);
+        emit_text(ctx, drum);
+      }
+      if(delay_cut && isalpha(this_note)) {
+        emit_int(ctx, delay_cut);
+        emit_bytes(ctx, "g r", 3);
+        delay_cut = 0;
+        bytes += 2+1;
+      }
+      write_duration(ctx, duration, slur|pattern[row].slur);
+    }
+    ctx->stats.notes++;
+    bytes += duration_bytes(duration);
+    if(legato != (slur|pattern[row].slur)) { // legato on and off are commands of their own
+      legato = slur|pattern[row].slur;
+      bytes++;
+      if(ca65)
+        ca65_byte(ctx, &count, legato ? "LEGATO_ON" : "LEGATO_OFF");
+    }
+
+    row = next;
+  }
+
+  if(ca65) {
+    // patterns loop, so any change to the transpose has to be undone first
+    if(transposed) {
+      emit(ctx, "\r\n  .byt TRANSPOSE, %i", -transposed);
+      bytes += 2;
+    }
+    emit_text(ctx, "\r\n  .byt PATEND");
+  }
+
+  if(!(ctx->options.transpose_patterns && channel_is_pitched(channel)
+       && share_transposed_pattern(ctx, label, pattern, length, start))
+     && (ctx->options.dedup_patterns || ctx->options.transpose_patterns))
+    share_pattern(ctx, label, start, key, skip, skip_end);
+
+  // only count it if it was actually written and not shared
+  if(!memcmp(label, &own, sizeof(own)))
+    add_pattern_cost(ctx, label, bytes);
+}
+
+// writes a pattern to the output file
+void write_pattern(ft2p_context *ctx, ftsong *xsong, int song_num, int id, int channel) {
+  int auto_noise = ctx->options.auto_noise, auto_dual_drums = ctx->options.auto_dual_drums;
+  ftpattern *p = xsong->pattern[id];
+  ftlabel *label = &p->label[channel];
+  label->song_num = song_num;
+  label->channel = channel;
+  label->id = id;
+  label->row = 0;
+  label->transpose = 0;
+  // skip over noise channel if auto_noise and auto_dual_drums are both off
+  // skip over DPCM channel if auto_noise or auto_dual_drums are on
+  if((channel == CH_NOISE && !(auto_noise || auto_dual_drums)) ||
+     (channel == CH_DPCM && (auto_noise || auto_dual_drums)))
+    return;
+
+  // find the instrument used for the pattern
+  int instrument = pattern_instrument(p->row[channel], xsong->rows);
+  if(instrument == -1)
+    error(ctx, 1, "note with no instrument %s", error_location(ctx, xsong, channel, id, -1));
+
+  int length = get_pattern_length(xsong, id, channel);
+  if(!p->pieces[channel]) {
+    write_rows(ctx, xsong, label, 0, length, instrument);
+    return;
+  }
+
+  // write each piece, or use the piece it's the same as
+  for(int i=0; i<p->pieces[channel]; i++) {
+    ftpiece *piece = &p->piece[channel][i];
+    if(piece->from_id != -1) {
+      piece->label = piece_at(xsong, piece->from_id, piece->from_channel, piece->from_row)->label;
+      continue;
+    }
+    int end = i+1 < p->pieces[channel] ? p->piece[channel][i+1].row : length;
+    piece->label = *label;
+    piece->label.row = piece->row;
+    write_rows(ctx, xsong, &piece->label, piece->row, end - piece->row, piece->instrument);
+  }
+  *label = p->piece[channel][0].label;
+}
+
+// finds the decay that can stand in for the end of a volume envelope (which ends in a zero)
+// by walking the decay trie backwards from the end, which takes time proportional to the envelope's length
+static void find_decay(ftmacro *macro) {
+  int best = DECAY_NO_MATCH, best_length = 0, node = 0;
+  for(int i=macro->length-2; i>=0; i--) {
+    int value = macro->sequence[i];
+    if(value < 0 || value > 15 || !(node = decay_trie[node][value]))
+      break;
+    if(decay_match[node] < best) {
+      best = decay_match[node];
+      best_length = macro->length-1-i;
+    }
+  }
+  if(best != DECAY_NO_MATCH) {
+    macro->decay_index = macro->length-1-best_length;
+    macro->decay_volume = MAX_DECAY_START - best/MAX_DECAY_RATE;
+    macro->decay_rate = best%MAX_DECAY_RATE + 1;
+  }
+}
+
+ft2p_context *ft2p_new(void) {
+  ft2p_context *ctx = calloc(1, sizeof(ft2p_context));
+  if(!ctx)
+    return NULL;
+  ctx->log.write = write_stdout;
+  return ctx;
+}
+
+//////////////////// automatic drums ////////////////////
+
+// writes a sound effect that plays an instrument
+static void write_sfx(ft2p_context *ctx, int instrument, int channel, const char *name, const char *long_name) {
+  intern_symbol(ctx, SYMBOL_SFX, name, long_name);
+  if(ctx->options.ca65) {
+    ctx->costs.sfx += 4 + 2*write_ca65_instrument(ctx, instrument, (channel != CH_NOISE)?ABSOLUTE_PITCH:0, name, channel);
+    return;
+  }
+  // sound effects don't like being put on "pulse1" so replace it with "pulse"
+  const char *channel_name = chan_name[channel];
+  if(channel == CH_SQUARE1)
+    channel_name = "pulse";
+  emit(ctx, "\r\nsfx %s on %s\r\n", name, channel_name);
+
+  // use absolute pitch for non-noise; decay disallowed
+  ctx->costs.sfx += 4 + 2*write_instrument(ctx, instrument, (channel != CH_NOISE)?ABSOLUTE_PITCH:0);
+}
+
+// what a drum has the noise and triangle channels doing on one frame, to tell how much alike two drums sound
+typedef struct drum_frame {
+  uint8_t volume, pitch, mode; // of the noise
+  int16_t triangle;            // semitone the triangle plays, or -1 if it's silent
+} drum_frame;
+
+// an envelope's value on a frame, holding its last value once it runs out
+static int macro_value(ft2p_context *ctx, int instrument, int set, int frame, int otherwise) {
+  if(ctx->instrument[instrument][set] < 0)
+    return otherwise;
+  const ftmacro *macro = &ctx->instrument_macro[set][ctx->instrument[instrument][set]];
+  if(!macro->length)
+    return otherwise;
+  return macro->sequence[frame < macro->length ? frame : macro->length-1];
+}
+
+// how many frames an instrument's envelopes last, or 0 for none (or 255)
+static int macro_frames(ft2p_context *ctx, int instrument) {
+  int frames = 0;
+  for(int set=0; instrument != 255 && set<MACRO_SET_COUNT; set++)
+    if(ctx->instrument[instrument][set] >= 0 && ctx->instrument_macro[set][ctx->instrument[instrument][set]].length > frames)
+      frames = ctx->instrument_macro[set][ctx->instrument[instrument][set]].length;
+  return frames;
+}
+
+// plays a drum the way its sound effects are written: a noise instrument moved up by "pitch", along with a triangle
+// instrument (or 255 for none); returns how many frames long it is
+static int render_drum(ft2p_context *ctx, int noise, int pitch, int triangle, drum_frame *frames) {
+  int length = macro_frames(ctx, noise);
+  if(macro_frames(ctx, triangle) > length)
+    length = macro_frames(ctx, triangle);
+  for(int i=0; i<length; i++) {
+    frames[i].volume = macro_value(ctx, noise, MS_VOLUME, i, 15) & 15;
+    frames[i].pitch = (macro_value(ctx, noise, MS_ARPEGGIO, i, 0) + pitch) & 15;
+    frames[i].mode = macro_value(ctx, noise, MS_DUTY, i, 0) & 1;
+    frames[i].triangle = -1;
+    if(triangle != 255 && macro_value(ctx, triangle, MS_VOLUME, i, 15))
+      frames[i].triangle = macro_value(ctx, triangle, MS_ARPEGGIO, i, 0);
+  }
+  return length;
+}
+
+// how different two drums sound; each frame adds how far apart the noise volumes are, how far apart the noise
+// pitches and modes are times how loud the quieter one is, and how differently the triangles play
+static int drum_distance(const drum_frame *a, int a_length, const drum_frame *b, int b_length) {
+  static const drum_frame silent = {0, 0, 0, -1};
+  int distance = 0;
+  for(int i=0; i<a_length || i<b_length; i++) {
+    const drum_frame *x = i < a_length ? &a[i] : &silent, *y = i < b_length ? &b[i] : &silent;
+    int quieter = x->volume < y->volume ? x->volume : y->volume;
+    distance += 4*abs(x->volume - y->volume) + quieter*(abs(x->pitch - y->pitch) + 4*(x->mode != y->mode));
+    if((x->triangle < 0) != (y->triangle < 0))
+      distance += 32;
+    else if(x->triangle >= 0)
+      distance += 2*(abs(x->triangle - y->triangle) < 12 ? abs(x->triangle - y->triangle) : 12);
+  }
+  return distance;
+}
+
+// renames drums where they're played in everything written so far, from "name" to "new_name" ("count" of each),
+// and moves the places they're played to where they end up
+static void rename_drums(ft2p_context *ctx, char (*name)[80], char (*new_name)[80], int count) {
+  ft2p_buffer old = ctx->out;
+  memset(&ctx->out, 0, sizeof(ctx->out));
+  size_t copied = 0;
+  for(int i=0; i<ctx->num_drum_refs; i++) {
+    ftdrumref *ref = &ctx->drum_refs[i];
+    emit_bytes(ctx, old.data+copied, ref->offset-copied);
+    copied = ref->offset;
+    ref->offset = ctx->out.length;
+    for(int k=0; k<count; k++)
+      if(!name[k][ref->length] && !memcmp(old.data+copied, name[k], ref->length)) {
+        emit_text(ctx, new_name[k]);
+        copied += ref->length;
+        ref->length = strlen(new_name[k]);
+        break;
+      }
+  }
+  emit_bytes(ctx, old.data+copied, old.length-copied);
+  free(old.data);
+}
+
+// when there are more drums than fit along with the ones already defined, merges the ones that sound the most alike,
+// keeping the earlier one of each pair, and plays the merged ones as the kept ones in everything written so far;
+// drum i is the noise instrument "noise[i]" moved up by "pitch[i]" with the triangle instrument "triangle[i]" (or 255),
+// and "played_as[i]" gets the drum it's played as, which is i if it's kept
+static void fit_drums(ft2p_context *ctx, const int *noise, const int *pitch, const uint8_t *triangle, char (*name)[80],
+                      int count, int *played_as) {
+  int budget = MAX_DRUMS - ctx->num_drums;
+  if(budget < 1)
+    budget = 1;
+  for(int i=0; i<count; i++)
+    played_as[i] = i;
+  if(count <= budget)
+    return;
+
+  drum_frame (*frames)[MAX_MACRO_LEN] = malloc(sizeof(*frames) * count);
+  int *length = malloc(sizeof(int) * count), *distance = malloc(sizeof(int) * count * count);
+  char (*old_name)[80] = malloc(sizeof(*old_name) * count), (*new_name)[80] = malloc(sizeof(*new_name) * count);
+  if(!frames || !length || !distance || !old_name || !new_name) {
+    free(frames);
+    free(length);
+    free(distance);
+    free(old_name);
+    free(new_name);
+    error(ctx, 1, "Out of memory");
+  }
+  for(int i=0; i<count; i++) {
+    length[i] = render_drum(ctx, noise[i], pitch[i], triangle[i], frames[i]);
+    for(int j=0; j<i; j++)
+      distance[j*count + i] = drum_distance(frames[j], length[j], frames[i], length[i]);
+  }
+
+  // merge the nearest pair of drums that are left until few enough are
+  for(int left=count; left>budget; left--) {
+    int best = -1, merged = -1;
+    for(int i=0; i<count; i++)
+      for(int j=i+1; played_as[i] == i && j<count; j++)
+        if(played_as[j] == j && (best < 0 || distance[i*count + j] < distance[best*count + merged])) {
+          best = i;
+          merged = j;
+        }
+    played_as[merged] = best;
+  }
+
+  // a drum may have been merged into one that was merged itself later
+  int renamed = 0;
+  for(int i=0; i<count; i++) {
+    while(played_as[played_as[i]] != played_as[i])
+      played_as[i] = played_as[played_as[i]];
+    if(played_as[i] == i)
+      continue;
+    log_printf(ctx, "Drum %s is played as %s to fit in %i drums\n", name[i], name[played_as[i]], MAX_DRUMS);
+    memcpy(old_name[renamed], name[i], sizeof(*name));
+    memcpy(new_name[renamed++], name[played_as[i]], sizeof(*name));
+  }
+  rename_drums(ctx, old_name, new_name, renamed);
+  free(frames);
+  free(length);
+  free(distance);
+  free(old_name);
+  free(new_name);
+}
+
+// writes the drums for auto dual drums, each with a sound effect for its noise part and maybe one for its triangle part
+static void write_auto_dual_drums(ft2p_context *ctx) {
+  int pitch[MAX_AUTO_DRUMS] = {0}, played_as[MAX_AUTO_DRUMS];
+  char name[MAX_AUTO_DRUMS][80];
+  for(int i=0; i<ctx->num_auto_drums; i++) {
+    // triangle parts come from an effect parameter, so they may not have been seen as instruments
+    if(ctx->auto_drum_tri[i] != 255)
+      need_instrument(ctx, ctx->auto_drum_tri[i]);
+    auto_drum_name(ctx, name[i], sizeof(name[i]), i);
+  }
+  fit_drums(ctx, ctx->auto_drum_noise, pitch, ctx->auto_drum_tri, name, ctx->num_auto_drums, played_as);
+
+  // create the noise and triangle sound effects for instruments that the drums use
+  const char *noise_sfx = ctx->options.short_names ? "n%x_" : "autonoise%x_";
+  const char *triangle_sfx = ctx->options.short_names ? "t%x_" : "autotriangle%x_";
+  for(int j=0; j<ctx->num_instruments; j++) {
+    char sfx[80], long_name[80];
+    for(int i=0; i<ctx->num_auto_drums; i++)
+      if(played_as[i] == i && ctx->auto_drum_noise[i] == j) {
+        snprintf(sfx, sizeof(sfx), noise_sfx, j);
+        snprintf(long_name, sizeof(long_name), "autonoise%x_", j);
+        write_sfx(ctx, j, CH_NOISE, sfx, long_name);
+        break;
+      }
+    for(int i=0; i<ctx->num_auto_drums; i++)
+      if(played_as[i] == i && ctx->auto_drum_tri[i] == j) {
+        snprintf(sfx, sizeof(sfx), triangle_sfx, j);
+        snprintf(long_name, sizeof(long_name), "autotriangle%x_", j);
+        write_sfx(ctx, j, CH_TRIANGLE, sfx, long_name);
+        break;
+      }
+  }
+
+  // create drums using both these sound effects
+  for(int i=0; i<ctx->num_auto_drums; i++) {
+    if(played_as[i] != i)
+      continue;
+    log_printf(ctx, "%i noise %x, triangle %x\n", i, ctx->auto_drum_noise[i], ctx->auto_drum_tri[i]);
+    ctx->costs.drums += 2;
+    ctx->num_drums++;
+    char drum[160], long_name[80];
+    int length = snprintf(drum, sizeof(drum), "%s ", name[i]);
+    length += snprintf(drum+length, sizeof(drum)-length, noise_sfx, ctx->auto_drum_noise[i]);
+    if(ctx->auto_drum_tri[i] != 255) {
+      drum[length++] = ' ';
+      snprintf(drum+length, sizeof(drum)-length, triangle_sfx, ctx->auto_drum_tri[i]);
+    }
+    snprintf(long_name, sizeof(long_name), "autodrum%i_", i);
+    intern_symbol(ctx, SYMBOL_DRUM, name[i], long_name);
+    if(ctx->options.ca65)
+      add_ca65_drum(ctx, drum);
+    else
+      emit(ctx, "\r\ndrum %s", drum);
+  }
+}
+
+// writes the drums for auto noise, one for each noise instrument and pitch that was played
+static void write_auto_noise_drums(ft2p_context *ctx) {
+  int count = 0;
+  for(int i=0; i<ctx->num_instruments; i++)
+    for(int j=0; j<16; j++)
+      count += (ctx->instrument_noise[i] >> j) & 1;
+  int *noise = malloc(sizeof(int) * (count+1)), *pitch = malloc(sizeof(int) * (count+1));
+  int *played_as = malloc(sizeof(int) * (count+1));
+  uint8_t *triangle = malloc(count+1);
+  char (*name)[80] = malloc(sizeof(*name) * (count+1));
+  if(!noise || !pitch || !played_as || !triangle || !name) {
+    free(noise);
+    free(pitch);
+    free(played_as);
+    free(triangle);
+    free(name);
+    error(ctx, 1, "Out of memory");
+  }
+  count = 0;
+  for(int i=0; i<ctx->num_instruments; i++)
+    for(int j=0; j<16; j++)
+      if(ctx->instrument_noise[i] & (1 << j)) {
+        noise[count] = i;
+        pitch[count] = j;
+        triangle[count] = 255;
+        snprintf(name[count++], sizeof(*name), "%s_%x_", ctx->instrument_name[i], j); // as write_rows() names them
+      }
+  fit_drums(ctx, noise, pitch, triangle, name, count, played_as);
+
+  for(int k=0; k<count; k++) {
+    if(played_as[k] != k)
+      continue;
+    int i = noise[k], j = pitch[k];
+    // make a new sound effect for the noise frequency
+    // the long name is the module's name for the instrument, so it's no longer than the instrument's own
+    char sfx[80], long_sfx[80], long_drum[80];
+    const char *long_instrument = long_symbol_name(ctx, SYMBOL_INSTRUMENT, ctx->instrument_name[i]);
+    int long_length = sizeof(*ctx->instrument_name)-1;
+    snprintf(sfx, sizeof(sfx), ctx->options.short_names ? "n%s_%x" : "noise_%s_%x", ctx->instrument_name[i], j);
+    snprintf(long_sfx, sizeof(long_sfx), "noise_%.*s_%x", long_length, long_instrument, j);
+    snprintf(long_drum, sizeof(long_drum), "%.*s_%x_", long_length, long_instrument, j);
+
+    // get the arpeggio envelope, change it and restore it to what it was
+    if(ctx->instrument[i][MS_ARPEGGIO] < 0) {
+      // no arpeggio set, so make one after all the others
+      ftmacro new_macro = {1, -1, -1, 0, {0}, 0, 0, 0};
+      int new_id = ctx->num_macros[MS_ARPEGGIO];
+      *need_macro(ctx, MS_ARPEGGIO, new_id) = new_macro;
+      ctx->instrument[i][MS_ARPEGGIO] = new_id;
+    }
+    unsigned int num_macro_arp    = (unsigned)ctx->instrument[i][MS_ARPEGGIO];
+    unsigned int num_macro_duty   = (unsigned)ctx->instrument[i][MS_DUTY];
+    int m;
+    if(ctx->instrument[i][MS_DUTY] >= 0) {
+      // if duty is used, wrap all duty values to 0 and 1
+      // we don't need to worry about saving and restoring because the macros
+      // won't be needed after the automatic noise drums are written
+      ftmacro *duty_macro = &ctx->instrument_macro[MS_DUTY][num_macro_duty];
+      for(m=0; m<duty_macro->length; m++)
+        duty_macro->sequence[m] &= 1;
+    }
+
+    ftmacro *arp_macro = &ctx->instrument_macro[MS_ARPEGGIO][num_macro_arp];
+    ftmacro old = *arp_macro;
+    for(m=0; m<arp_macro->length; m++)
+      arp_macro->sequence[m] = (arp_macro->sequence[m]+j)&15;
+    write_sfx(ctx, i, CH_NOISE, sfx, long_sfx);
+    *arp_macro = old;
+
+    // define a drum for the frequency
+    char drum[160];
+    snprintf(drum, sizeof(drum), "%s %s", name[k], sfx);
+    intern_symbol(ctx, SYMBOL_DRUM, name[k], long_drum);
+    if(ctx->options.ca65)
+      add_ca65_drum(ctx, drum);
+    else
+      emit(ctx, "\r\ndrum %s", drum);
+    ctx->costs.drums += 2;
+    ctx->num_drums++;
+  }
+  free(noise);
+  free(pitch);
+  free(played_as);
+  free(triangle);
+  free(name);
+}
+
+//////////////////// rendering ////////////////////
+// plays a song the way Famitracker would, straight from what was read of the module, through a model of the 2A03's
+// pulse, triangle and noise channels; DPCM, expansion channels, vibrato and release points aren't played
+
+#define CPU_HZ   1789773.0 // NTSC
+#define FRAME_HZ 60.0988
+
+// frequency of C-0, then how much higher each semitone is
+#define C0_HZ 16.351597831287414
+static const double semitone_ratio[NUM_SEMITONES] = {
+  1.0, 1.0594630943592953, 1.1224620483093730, 1.1892071150027210, 1.2599210498948732, 1.3348398541700344,
+  1.4142135623730951, 1.4983070768766815, 1.5874010519681994, 1.6817928305074290, 1.7817974362806785, 1.8877486253633868
+};
+
+// the noise channel's periods in CPU cycles, from its highest pitch (F-#) down to its lowest (0-#)
+static const int noise_period[16] = {4, 8, 16, 32, 64, 96, 128, 160, 202, 254, 380, 508, 762, 1016, 2034, 4068};
+
+static const uint8_t duty_wave[4][8] = {
+  {0, 1, 0, 0, 0, 0, 0, 0}, {0, 1, 1, 0, 0, 0, 0, 0}, {0, 1, 1, 1, 1, 0, 0, 0}, {1, 0, 0, 1, 1, 1, 1, 1}
+};
+
+// what one channel is playing, and what its part of the sound chip is doing
+typedef struct render_channel {
+  int playing;         // from a note until a note cut
+  int note;            // semitone counted from C-0, or the noise pitch from 0 to 15
+  int instrument;      // or -1
+  int volume;          // VOL_* from the volume column
+  int slur;            // nonzero if the note slurs into the next one
+  int arpeggio;        // 0xy effect
+  int frames;          // since the note started, which is how far along its envelopes are
+  int relative_arp, pitch_offset; // relative arpeggios and pitch envelopes add up from frame to frame
+  int delay, cut;      // frames until a delayed note, and until a delayed cut, or 0
+  const ftnote *delayed;
+  // the chip, on the current frame
+  int period, level, duty;
+  uint32_t phase;      // pulse or triangle position in its waveform, as a fraction of the whole
+  uint32_t cycles;     // noise CPU cycles since the shift register last moved, times 65536
+  uint16_t shift;      // noise shift register
+} render_channel;
+
+// one of the envelopes a channel's instrument has, or NULL
+static const ftmacro *render_macro(ft2p_context *ctx, const render_channel *ch, int set) {
+  if(ch->instrument < 0 || ch->instrument >= ctx->num_instruments)
+    return NULL;
+  int id = ctx->instrument[ch->instrument][set];
+  return id >= 0 && id < ctx->num_macros[set] ? &ctx->instrument_macro[set][id] : NULL;
+}
+
+// starts a note, or carries on into it from the last one if that one slurred
+static void render_note(render_channel *ch, int channel, const ftnote *note) {
+  if(note->note == '-') {
+    ch->playing = 0;
+    return;
+  }
+  if(!isalnum(note->note))
+    return;
+  if(note->instrument >= 0)
+    ch->instrument = note->instrument;
+  if(channel == CH_NOISE)
+    ch->note = isdigit(note->note) ? note->note-'0' : tolower(note->note)-'a'+10;
+  else
+    ch->note = note_to_semitone(note->note, note->octave);
+  if(!ch->playing || !ch->slur)
+    ch->frames = ch->relative_arp = ch->pitch_offset = 0;
+  ch->playing = 1;
+  ch->slur = note->slur;
+}
+
+// does what's on a row of one channel
+static void render_row(render_channel *ch, int channel, const ftnote *note) {
+  ch->delay = ch->cut = 0;
+  for(int i=0; i<MAX_EFFECTS; i++) {
+    if(note->effect[i] == FX_ARP)
+      ch->arpeggio = note->param[i];
+    else if(note->effect[i] == FX_DELAY && note->param[i])
+      ch->delay = note->param[i]+1;
+    else if(note->effect[i] == FX_DELAYCUT)
+      ch->cut = note->param[i]+1;
+  }
+  if(note->volume)
+    ch->volume = note->volume;
+  if(ch->delay)
+    ch->delayed = note;
+  else
+    render_note(ch, channel, note);
+}
+
+// works out what a channel has the chip do for one frame
+static void render_frame(ft2p_context *ctx, render_channel *ch, int channel) {
+  if(ch->delay && !--ch->delay)
+    render_note(ch, channel, ch->delayed);
+  if(ch->cut && !--ch->cut)
+    ch->playing = 0;
+  ch->level = 0;
+  if(!ch->playing)
+    return;
+
+  const ftmacro *arp = render_macro(ctx, ch, MS_ARPEGGIO);
+  int frame = ch->frames++, volume = envelope_value(render_macro(ctx, ch, MS_VOLUME), frame, 15);
+  ch->duty = envelope_value(render_macro(ctx, ch, MS_DUTY), frame, 0);
+  ch->pitch_offset += envelope_value(render_macro(ctx, ch, MS_PITCH), frame, 0)
+                    + 16*envelope_value(render_macro(ctx, ch, MS_HIPITCH), frame, 0);
+  int note = ch->note;
+  if(arp && arp->arp_type == ARP_FIXED && arp->length)
+    note = envelope_value(arp, frame, 0);
+  else if(arp && arp->arp_type == ARP_RELATIVE)
+    note += ch->relative_arp += envelope_value(arp, frame, 0);
+  else
+    note += envelope_value(arp, frame, 0);
+  if(ch->arpeggio) {
+    int step = frame % ((ch->arpeggio & 15) ? 3 : 2);
+    note += step == 1 ? ch->arpeggio >> 4 : step == 2 ? ch->arpeggio & 15 : 0;
+  }
+
+  // the volume column takes the envelope down by quarters, rounding up so it doesn't go silent
+  static const int quarters[] = {4, 4, 3, 2, 1};
+  volume = (volume * quarters[ch->volume] + 3) / 4;
+  if(channel == CH_NOISE) {
+    ch->period = noise_period[(note & 15) ^ 15];
+    ch->level = volume & 15;
+    return;
+  }
+  if(note < 0)
+    note = 0;
+  if(note >= NUM_OCTAVES*NUM_SEMITONES)
+    note = NUM_OCTAVES*NUM_SEMITONES-1;
+  double frequency = C0_HZ * semitone_ratio[note % NUM_SEMITONES] * (1 << (note / NUM_SEMITONES));
+  ch->period = (int)(CPU_HZ / ((channel == CH_TRIANGLE ? 32 : 16) * frequency) - 0.5) + ch->pitch_offset;
+  if(ch->period > 0x7ff)
+    ch->period = 0x7ff;
+  // the triangle only has on and off, and the chip mutes pulses that are too high
+  if(channel == CH_TRIANGLE)
+    ch->level = volume && ch->period >= 2;
+  else
+    ch->level = ch->period >= 8 ? volume & 15 : 0;
+}
+
+// fills in what a channel outputs over "count" samples, from 0 to 15
+static void render_samples(render_channel *ch, int channel, float *out, int count, double cycles_per_sample) {
+  if(channel == CH_NOISE) {
+    uint32_t step = (uint32_t)(cycles_per_sample * 65536), period = (uint32_t)ch->period << 16;
+    int tap = (ch->duty & 1) ? 6 : 1;
+    for(int i=0; i<count; i++) {
+      for(ch->cycles += step; ch->cycles >= period; ch->cycles -= period)
+        ch->shift = (ch->shift >> 1) | (((ch->shift ^ (ch->shift >> tap)) & 1) << 14);
+      out[i] = (ch->shift & 1) ? 0 : ch->level;
+    }
+  } else if(channel == CH_TRIANGLE) {
+    // a silent triangle stays where it stopped instead of going back to the middle, like the real one
+    uint32_t step = ch->level ? (uint32_t)(4294967296.0 * cycles_per_sample / (32.0 * (ch->period+1))) : 0;
+    for(int i=0; i<count; i++, ch->phase += step) {
+      int position = ch->phase >> 27;
+      out[i] = position < 16 ? 15-position : position-16;
+    }
+  } else {
+    uint32_t step = (uint32_t)(4294967296.0 * cycles_per_sample / (16.0 * (ch->period+1)));
+    const uint8_t *wave = duty_wave[ch->duty & 3];
+    for(int i=0; i<count; i++, ch->phase += step)
+      out[i] = wave[ch->phase >> 29] * ch->level;
+  }
+}
+
+// mixes the channels with the usual linear approximation of the NES's mixer; no sample depends on another,
+// so compilers can vectorize it
+static void mix_samples(float *restrict out, const float *restrict pulse1, const float *restrict pulse2,
+                        const float *restrict triangle, const float *restrict noise, int count) {
+  for(int i=0; i<count; i++)
+    out[i] = 0.00752f*(pulse1[i] + pulse2[i]) + 0.00851f*triangle[i] + 0.00494f*noise[i];
+}
+
+// writes a number least significant byte first, and returns where the next one goes
+static uint8_t *put_le(uint8_t *p, uint32_t value, int bytes) {
+  for(int i=0; i<bytes; i++)
+    *p++ = value >> (8*i);
+  return p;
+}
+
+// plays a song once through from its first frame to the end of its last one, and sends it to ctx->render as a
+// mono 16-bit WAV file
+static void render_song(ft2p_context *ctx, ftsong *xsong, int song_num) {
+  static const int channels[] = {CH_SQUARE1, CH_SQUARE2, CH_TRIANGLE, CH_NOISE};
+  int rate = ctx->options.render_rate;
+  check_range(ctx, "render rate", rate, 8000, 192000, NULL);
+  double cycles_per_sample = CPU_HZ / rate, samples_per_frame = rate / FRAME_HZ, due = 0;
+  int block = (int)samples_per_frame + 2;
+  float *levels = malloc(sizeof(float) * block * 5); // each channel's, then the mix
+  ft2p_buffer wav = {malloc(65536), 44, 65536};     // the header goes in at the end, once the length is known
+  if(!levels || !wav.data) {
+    free(levels);
+    free(wav.data);
+    error(ctx, 1, "Out of memory");
+  }
+  float *mixed = levels + 4*block, last_in = 0, last_out = 0;
+
+  render_channel state[4];
+  memset(state, 0, sizeof(state));
+  for(int i=0; i<4; i++) {
+    state[i].instrument = -1;
+    state[i].period = 0x7ff; // until the first note
+    state[i].shift = 1;
+  }
+  int speed = xsong->speed > 0 ? xsong->speed : 6, tempo = xsong->tempo > 0 ? xsong->tempo : 150, ticks = 0;
+  const ftcontrol *control = xsong->control, *controls_end = xsong->control + xsong->controls;
+  for(int frame=0; frame<xsong->frames; frame++) {
+    int next_event[4] = {0};
+    for(int row=xsong->frame_start[frame]; row<xsong->frame_start[frame+1]; row++) {
+      for(; control < controls_end && control->row <= row; control++) {
+        if(control->speed)
+          speed = control->speed;
+        if(control->tempo)
+          tempo = control->tempo;
+      }
+      for(int i=0; i<4; i++) {
+        int id = xsong->frame[frame][channels[i]], pattern_row = row - xsong->frame_start[frame];
+        if(!get_pattern(xsong, id, channels[i]))
+          continue;
+        const ftpattern *p = xsong->pattern[id];
+        const ftevent *events = p->event[channels[i]];
+        while(next_event[i] < p->events[channels[i]] && events[next_event[i]].row < pattern_row)
+          next_event[i]++;
+        if(next_event[i] < p->events[channels[i]] && events[next_event[i]].row == pattern_row)
+          render_row(&state[i], channels[i], &p->row[channels[i]][pattern_row]);
+      }
+
+      // play frames until the next row; the tempo counts up 24 times a frame, and each tick of speed takes 3600
+      do {
+        for(int i=0; i<4; i++)
+          render_frame(ctx, &state[i], channels[i]);
+        due += samples_per_frame;
+        int count = (int)due;
+        due -= count;
+        for(int i=0; i<4; i++)
+          render_samples(&state[i], channels[i], levels + i*block, count, cycles_per_sample);
+        mix_samples(mixed, levels, levels+block, levels+2*block, levels+3*block, count);
+
+        if(wav.length + 2*count > wav.capacity) {
+          char *grown = realloc(wav.data, wav.capacity*2);
+          if(!grown) {
+            free(levels);
+            free(wav.data);
+            error(ctx, 1, "Out of memory");
+          }
+          wav.data = grown;
+          wav.capacity *= 2;
+        }
+        // take out the DC offset the way the NES's own high-pass filter does, and make 16-bit samples
+        uint8_t *p = (uint8_t*)wav.data + wav.length;
+        for(int i=0; i<count; i++) {
+          last_out = mixed[i] - last_in + 0.996f*last_out;
+          last_in = mixed[i];
+          float sample = last_out * 65536;
+          p = put_le(p, (uint16_t)(int16_t)(sample > 32767 ? 32767 : sample < -32768 ? -32768 : sample), 2);
+        }
+        wav.length += 2*count;
+        ticks += tempo * 24;
+      } while(ticks < speed * 3600);
+      ticks -= speed * 3600;
+    }
+  }
+
+  uint32_t data_length = wav.length - 44;
+  uint8_t *p = (uint8_t*)wav.data;
+  memcpy(p, "RIFF", 4);
+  p = put_le(p+4, data_length + 36, 4);
+  memcpy(p, "WAVEfmt ", 8);
+  p = put_le(p+8, 16, 4);
+  p = put_le(p, 1, 2); // PCM
+  p = put_le(p, 1, 2); // mono
+  p = put_le(p, rate, 4);
+  p = put_le(p, rate*2, 4);
+  p = put_le(p, 2, 2);
+  p = put_le(p, 16, 2);
+  memcpy(p, "data", 4);
+  put_le(p+4, data_length, 4);
+  ctx->render.write(ctx->render.user, song_num, xsong->name, wav.data, wav.length);
+  free(levels);
+  free(wav.data);
+}
+
+//////////////////// song cache ////////////////////
+
+#define SONG_CACHE_VERSION 4
+
+// what's stored for a song that was written: what writing it changed besides the output, and then
+// num_noise (instrument, frequencies) pairs, num_pattern_costs ft2p_pattern_costs, num_drum_refs ftdrumrefs (from the
+// start of the song) and text_length bytes of output
+typedef struct song_cache_entry {
+  int version;
+  int patterns, conductor;
+  int num_auto_drums;
+  int auto_drum_noise[MAX_AUTO_DRUMS];
+  uint8_t auto_drum_tri[MAX_AUTO_DRUMS];
+  int num_noise, num_pattern_costs, num_drum_refs;
+  int pieces_factored, pieces_shared, factor_bytes_saved;
+  size_t text_length;
+} song_cache_entry;
+
+// songs can only be reused if writing them doesn't depend on the songs before them,
+// which isn't the case when patterns are shared between songs
+static int song_cache_usable(ft2p_context *ctx) {
+  return ctx->song_cache.load && !ctx->options.dedup_patterns && !ctx->options.transpose_patterns;
+}
+
+// a song's key covers its own lines, everything outside of songs read so far, the options,
+// and the automatic drums that earlier songs made
+static uint64_t song_cache_key(ft2p_context *ctx, ftsong *xsong, int song_num) {
+  uint64_t hash = ft2p_hash(FT2P_HASH_START, &xsong->hash, sizeof(xsong->hash));
+  hash = ft2p_hash(hash, &xsong->global_hash, sizeof(xsong->global_hash));
+  hash = ft2p_hash(hash, &song_num, sizeof(song_num));
+  ft2p_options options = ctx->options; // without the ones that don't change what's written
+  options.pipeline = options.song_threads = options.stats = options.budget = options.render_rate = 0;
+  hash = ft2p_hash(hash, &options, sizeof(options));
+  hash = ft2p_hash(hash, xsong->name, strlen(xsong->name));
+  hash = ft2p_hash(hash, &ctx->num_auto_drums, sizeof(ctx->num_auto_drums));
+  hash = ft2p_hash(hash, ctx->auto_drum_noise, sizeof(ctx->auto_drum_noise));
+  return ft2p_hash(hash, ctx->auto_drum_tri, sizeof(ctx->auto_drum_tri));
+}
+
+// writes a song from the cache if it's there; returns 1 if it was
+static int load_cached_song(ft2p_context *ctx, uint64_t key) {
+  size_t length;
+  char *data = ctx->song_cache.load(ctx->song_cache.user, key, &length);
+  if(!data)
+    return 0;
+  song_cache_entry entry;
+  if(length < sizeof(entry)) {
+    free(data);
+    return 0;
+  }
+  memcpy(&entry, data, sizeof(entry));
+  size_t noise_size = sizeof(int[2]) * entry.num_noise, costs_size = sizeof(ft2p_pattern_cost) * entry.num_pattern_costs;
+  size_t refs_size = sizeof(ftdrumref) * entry.num_drum_refs;
+  if(entry.version != SONG_CACHE_VERSION || entry.num_noise < 0 || entry.num_pattern_costs < 0 || entry.num_drum_refs < 0
+     || entry.num_auto_drums < 0 || entry.num_auto_drums > MAX_AUTO_DRUMS
+     || length != sizeof(entry) + noise_size + costs_size + refs_size + entry.text_length) {
+    free(data);
+    return 0;
+  }
+
+  const char *next = data + sizeof(entry);
+  for(int i=0; i<entry.num_noise; i++, next += sizeof(int[2])) {
+    int noise[2];
+    memcpy(noise, next, sizeof(noise));
+    if(noise[0] >= 0 && noise[0] < ctx->instruments_allocated)
+      ctx->instrument_noise[noise[0]] |= noise[1];
+  }
+  for(int i=0; i<entry.num_pattern_costs; i++, next += sizeof(ft2p_pattern_cost)) {
+    ft2p_pattern_cost cost;
+    memcpy(&cost, next, sizeof(cost));
+    add_pattern_cost(ctx, &cost.label, cost.bytes);
+  }
+  for(int i=0; i<entry.num_drum_refs; i++, next += sizeof(ftdrumref)) {
+    ftdrumref ref;
+    memcpy(&ref, next, sizeof(ref));
+    ctx->drum_refs = grow_array(ctx, ctx->drum_refs, &ctx->drum_refs_allocated, ctx->num_drum_refs+1, sizeof(ftdrumref));
+    ctx->drum_refs[ctx->num_drum_refs] = ref;
+    ctx->drum_refs[ctx->num_drum_refs++].offset += ctx->out.length;
+  }
+  ctx->num_auto_drums = entry.num_auto_drums;
+  memcpy(ctx->auto_drum_noise, entry.auto_drum_noise, sizeof(ctx->auto_drum_noise));
+  memcpy(ctx->auto_drum_tri, entry.auto_drum_tri, sizeof(ctx->auto_drum_tri));
+  ctx->pieces_factored += entry.pieces_factored;
+  ctx->pieces_shared += entry.pieces_shared;
+  ctx->factor_bytes_saved += entry.factor_bytes_saved;
+  emit_bytes(ctx, next, entry.text_length);
+
+  ft2p_song_cost *cost = &ctx->costs.song[ctx->costs.num_songs-1];
+  cost->patterns = entry.patterns;
+  cost->conductor = entry.conductor;
+  free(data);
+  return 1;
+}
+
+// stores a song that was just written, starting at "start" in the output; "noise" is what
+// instrument_noise was before, "first_cost" is the first of the song's pattern costs, "first_ref" the first of
+// its drum refs, and "factored" is what pieces_factored, pieces_shared and factor_bytes_saved were before
+static void save_cached_song(ft2p_context *ctx, uint64_t key, size_t start, const uint16_t *noise, int first_cost,
+                             int first_ref, const int *factored) {
+  song_cache_entry entry;
+  memset(&entry, 0, sizeof(entry));
+  entry.version = SONG_CACHE_VERSION;
+  ft2p_song_cost *cost = &ctx->costs.song[ctx->costs.num_songs-1];
+  entry.patterns = cost->patterns;
+  entry.conductor = cost->conductor;
+  entry.num_auto_drums = ctx->num_auto_drums;
+  memcpy(entry.auto_drum_noise, ctx->auto_drum_noise, sizeof(entry.auto_drum_noise));
+  memcpy(entry.auto_drum_tri, ctx->auto_drum_tri, sizeof(entry.auto_drum_tri));
+  for(int i=0; i<ctx->instruments_allocated; i++)
+    if(ctx->instrument_noise[i] & ~noise[i])
+      entry.num_noise++;
+  entry.num_pattern_costs = ctx->costs.num_patterns - first_cost;
+  entry.num_drum_refs = ctx->num_drum_refs - first_ref;
+  entry.pieces_factored = ctx->pieces_factored - factored[0];
+  entry.pieces_shared = ctx->pieces_shared - factored[1];
+  entry.factor_bytes_saved = ctx->factor_bytes_saved - factored[2];
+  entry.text_length = ctx->out.length - start;
+
+  size_t length = sizeof(entry) + sizeof(int[2])*entry.num_noise + sizeof(ft2p_pattern_cost)*entry.num_pattern_costs
+                  + sizeof(ftdrumref)*entry.num_drum_refs + entry.text_length;
+  char *data = malloc(length), *next = data;
+  if(!data)
+    return; // not being able to cache a song isn't worth stopping for
+  memcpy(next, &entry, sizeof(entry));
+  next += sizeof(entry);
+  for(int i=0; i<ctx->instruments_allocated; i++)
+    if(ctx->instrument_noise[i] & ~noise[i]) {
+      int pair[2] = {i, ctx->instrument_noise[i] & ~noise[i]};
+      memcpy(next, pair, sizeof(pair));
+      next += sizeof(pair);
+    }
+  memcpy(next, ctx->costs.pattern + first_cost, sizeof(ft2p_pattern_cost)*entry.num_pattern_costs);
+  next += sizeof(ft2p_pattern_cost)*entry.num_pattern_costs;
+  for(int i=0; i<entry.num_drum_refs; i++, next += sizeof(ftdrumref)) {
+    ftdrumref ref = ctx->drum_refs[first_ref+i];
+    ref.offset -= start;
+    memcpy(next, &ref, sizeof(ref));
+  }
+  memcpy(next, ctx->out.data + start, entry.text_length);
+  ctx->song_cache.save(ctx->song_cache.user, key, data, length);
+  free(data);
+}
+
+// writes the conductor's command to play a pattern on a channel
+static void write_play(ft2p_context *ctx, const ftlabel *label, int channel) {
+  emit_text(ctx, "\r\n  play ");
+  write_pattern_name(ctx, label);
+  if(label->channel != channel) // shared with a pattern from another channel
+    emit(ctx, " on %s", chan_name[channel]);
+  if(label->transpose)
+    emit(ctx, " %s %i", label->transpose > 0 ? "up" : "down", abs(label->transpose));
+}
+
+// finds the first row at or after "row" where a piece of a split pattern starts partway through a frame,
+// on a channel that played the pattern, or returns MAX_ROWS if there isn't one
+static int next_piece_row(ftsong *xsong, const int *frame, const int *played, int row) {
+  int found = MAX_ROWS;
+  for(int j=0; j<CHANNEL_COUNT; j++) {
+    if(!played[j])
+      continue;
+    ftpattern *p = xsong->pattern[frame[j]];
+    for(int k=1; k<p->pieces[j]; k++)
+      if(p->piece[j][k].row >= row) {
+        if(p->piece[j][k].row < found)
+          found = p->piece[j][k].row;
+        break;
+      }
+  }
+  return found;
+}
+
+// writes a song's patterns and the frames that play them
+void write_song(ft2p_context *ctx, ftsong *xsong, int song_num) {
+  int i, j;
+  double start = ctx->options.stats ? seconds_now() : 0;
+  size_t song_start = ctx->out.length;
+
+  // play the song before writing it changes any of its patterns
+  if(ctx->options.render_rate && ctx->render.write) {
+    render_song(ctx, xsong, song_num);
+    double rendered = ctx->options.stats ? seconds_now() : 0;
+    ctx->stats.seconds[PHASE_RENDER] += rendered - start;
+    start = rendered;
+  }
+
+  // see if this song was written before, and remember what writing it changes if it wasn't
+  int caching = song_cache_usable(ctx), first_cost = ctx->costs.num_patterns, first_ref = ctx->num_drum_refs;
+  int factored[3] = {ctx->pieces_factored, ctx->pieces_shared, ctx->factor_bytes_saved};
+  uint64_t key = 0;
+  uint16_t *noise = NULL;
+  if(caching) {
+    key = song_cache_key(ctx, xsong, song_num);
+    ft2p_song_cost *cost = &ctx->costs.song[ctx->costs.num_songs++];
+    strlcpy(cost->name, xsong->name, sizeof(cost->name));
+    if(load_cached_song(ctx, key)) {
+      ctx->stats.songs_cached++;
+      return;
+    }
+    ctx->costs.num_songs--;
+    noise = malloc(sizeof(uint16_t) * (ctx->instruments_allocated ? ctx->instruments_allocated : 1));
+    if(noise)
+      memcpy(noise, ctx->instrument_noise, sizeof(uint16_t) * ctx->instruments_allocated);
+  }
+  int auto_noise = ctx->options.auto_noise, auto_dual_drums = ctx->options.auto_dual_drums;
+  int ca65 = ctx->options.ca65, now = 0; // ca65's conductor waits from one row to the next instead of using "at"
+  if(ca65) {
+    emit(ctx, "\r\n\r\n; %s\r\n", xsong->real_name);
+  } else {
+    emit(ctx, "\r\nsong %s\r\n  time 4/4\r\n  scale 16\r\n  title %s\r\n", xsong->name, xsong->real_name);
+    write_tempo(ctx, xsong->speed, xsong->tempo);
+    emit_text(ctx, "\r\n");
+  }
+
+  // the song's entry in the song table and its starting tempo
+  ft2p_song_cost *cost = &ctx->costs.song[ctx->costs.num_songs++];
+  strlcpy(cost->name, xsong->name, sizeof(cost->name));
+  cost->patterns = 0;
+  cost->conductor = 2+3;
+
+  // write the patterns that aren't empty, which index_song_events() found
+  if(ctx->options.factor_patterns)
+    factor_song(ctx, xsong);
+  for(j=0; j<CHANNEL_COUNT; j++)
+    for(i=0; i<xsong->patterns_allocated; i++) {
+      if(!get_pattern(xsong, i, j))
+        continue;
+      if(xsong->pattern[i]->used[j]) {
+        write_pattern(ctx, xsong, song_num, i, j);
+        ctx->stats.patterns_written++;
+      } else {
+        ctx->stats.patterns_empty++;
+      }
+    }
+  double patterns_done = ctx->options.stats ? seconds_now() : 0;
+  ctx->stats.seconds[PHASE_PATTERNS] += patterns_done - start;
+  if(ca65) {
+    emit(ctx, "\r\nsong_%s:", xsong->name);
+    write_ca65_tempo(ctx, xsong->speed, xsong->tempo);
+  }
+
+  // write the frames
+  int channel_playing[CHANNEL_COUNT] = {1, 1, 1, auto_noise||auto_dual_drums, !(auto_noise||auto_dual_drums), 0};
+  const ftcontrol *control = xsong->control, *controls_end = xsong->control + xsong->controls;
+  for(i=0; i<xsong->frames; i++) {
+    int total_rows = xsong->frame_start[i], length = xsong->frame_start[i+1] - total_rows;
+    if(ca65) {
+      write_ca65_wait(ctx, &now, total_rows);
+    } else {
+      emit_text(ctx, "\r\n  at ");
+      write_time(ctx, total_rows);
+    }
+    if(total_rows)
+      cost->conductor += 2; // wait
+    if(control < controls_end && control->row == total_rows && control->segno) {
+      emit_text(ctx, "\r\n  segno");
+      cost->conductor++;
+    }
+
+    int played[CHANNEL_COUNT] = {0}; // channels that started a pattern in this frame
+    for(j=0; j<CHANNEL_COUNT; j++) {
+      int pattern = xsong->frame[i][j];
+      if(( (!(auto_noise||auto_dual_drums) && j != CH_NOISE)
+         || ((auto_noise||auto_dual_drums) && j != CH_DPCM))
+        && get_pattern_used(xsong, pattern, j)) {
+        ftlabel *label = &xsong->pattern[pattern]->label[j];
+        if(ca65) {
+          // pitched patterns are played at their transpose, with the instrument they start with
+          ftnote *notes = get_pattern(xsong, pattern, j);
+          char name[64];
+          pattern_constant(name, sizeof(name), label, ctx->options.short_names);
+          emit(ctx, "\r\n  playPat%s %s, ", ca65_tracks[j], name);
+          if(channel_is_pitched(j))
+            emit(ctx, "%i, PI_%s", ca65_pattern_base(notes, get_pattern_length(xsong, pattern, j)),
+                 ctx->instrument_name[pattern_instrument(notes, xsong->rows)]);
+          else
+            emit_text(ctx, "0, 0");
+        } else {
+          write_play(ctx, label, j);
+        }
+        channel_playing[j] = 1;
+        played[j] = 1;
+        cost->conductor += 4; // command and track, pattern, transpose, instrument
+      } else if(channel_playing[j]) { // stop channel if it was playing but now it isn't
+        if(ca65)
+          emit(ctx, "\r\n  stopPat%s", ca65_tracks[j]);
+        else if(j == CH_NOISE || j == CH_DPCM)
+          emit_text(ctx, "\r\n  stop drum");
+        else
+          emit(ctx, "\r\n  stop %s", chan_name[j]);
+        channel_playing[j] = 0;
+        cost->conductor += 4;
+      }
+    }
+
+    // follow the timeline through the frame, along with pieces of split patterns that start partway through
+    for(int row=0; ; row++) {
+      int piece_row = next_piece_row(xsong, xsong->frame[i], played, row);
+      int control_row = control < controls_end ? control->row - total_rows : MAX_ROWS;
+      row = piece_row < control_row ? piece_row : control_row;
+      if(row >= length)
+        break;
+      int speed = 0, tempo = 0, attack=-1;
+      if(row == control_row) {
+        speed = control->speed;
+        tempo = control->tempo;
+        attack = control->attack;
+        control++;
+      }
+      ftpiece *piece[CHANNEL_COUNT] = {NULL}, *pieces = NULL;
+      for(int j=0; j<CHANNEL_COUNT; j++)
+        if(row && played[j] && (piece[j] = piece_at(xsong, xsong->frame[i][j], j, row)))
+          pieces = piece[j];
+      if(speed||tempo||(attack>=0)||pieces) {
+        if(row && ca65) {
+          write_ca65_wait(ctx, &now, total_rows+row);
+          cost->conductor += 2;
+        } else if(row) {
+          emit_text(ctx, "\r\n  at ");
+          write_time(ctx, total_rows+row);
+          cost->conductor += 2;
+        }
+        for(int j=0; j<CHANNEL_COUNT; j++)
+          if(piece[j]) {
+            write_play(ctx, &piece[j]->label, j);
+            cost->conductor += 4;
+          }
+        if(speed||tempo) {
+          if(ca65) {
+            write_ca65_tempo(ctx, speed?speed:xsong->speed, tempo?tempo:xsong->tempo);
+          } else {
+            emit_text(ctx, "\r\n");
+            write_tempo(ctx, speed?speed:xsong->speed, tempo?tempo:xsong->tempo);
+          }
+          cost->conductor += 3;
+        }
+        if(attack>=0 && ca65) {
+          check_range(ctx, "attack channel", attack, 0, CH_NOISE, error_location(ctx, xsong, CH_ATTACK, xsong->frame[i][CH_ATTACK], row));
+          emit(ctx, "\r\n  attackOn%s", ca65_tracks[attack]);
+          cost->conductor++;
+        } else if(attack>=0) {
+          emit(ctx, "\r\n  attack on %s", chan_name[attack]);
+          cost->conductor++;
+        }
+      }
+    }
+  }
+  int total_rows = xsong->frame_start[xsong->frames];
+  cost->conductor += 2+1; // wait, then fine or dal segno
+  if(ca65) {
+    write_ca65_wait(ctx, &now, total_rows);
+    emit_text(ctx, xsong->loop_to != -1 ? "\r\n  dalSegno" : "\r\n  fine");
+  } else {
+    emit_text(ctx, "\r\n  at ");
+    write_time(ctx, total_rows);
+    emit_text(ctx, "\r\n  ");
+    if(xsong->loop_to != -1)
+      emit_text(ctx, "dal segno");
+    else
+      emit_text(ctx, "fine");
+  }
+  if(ctx->options.stats)
+    ctx->stats.seconds[PHASE_CONDUCTOR] += seconds_now() - patterns_done;
+
+  if(noise) {
+    save_cached_song(ctx, key, song_start, noise, first_cost, first_ref, factored);
+    free(noise);
+  }
+}
+
+//////////////////// binary modules ////////////////////
+
+// a .ftm or .0cc module is turned into the text export Famitracker would have written for it,
+// so it goes through exactly the same parsing as an export does
+
+#define MODULE_ID        "FamiTracker Module"
+#define MODULE_CHANNELS  32  // more than every expansion chip at once
+#define MODULE_NO_INST   0x40
+#define MODULE_NO_VOLUME 0x10
+#define MODULE_NOISE     3   // channel type of the 2A03 noise channel
+
+// one block of a module, found by its name
+typedef struct module_block {
+  const char *name;
+  const uint8_t *data, *end;
+  int version;
+} module_block;
+
+// where reading is up to in a block
+typedef struct module_reader {
+  ft2p_context *ctx;
+  const uint8_t *p, *end;
+  const char *block;
+} module_reader;
+
+// a macro, kept until its release point and setting are read at the end of the block
+typedef struct module_sequence {
+  int index, type, loop, release, setting, length;
+  const uint8_t *values;
+} module_sequence;
+
+// one channel of one pattern in the PATTERNS block
+typedef struct module_pattern {
+  int track, channel, pattern, items;
+  const uint8_t *data;
+} module_pattern;
+
+// a cell of a pattern, as the module stores it
+typedef struct module_cell {
+  uint8_t note, octave, instrument, volume;
+  uint8_t effect[MAX_EFFECTS], param[MAX_EFFECTS];
+} module_cell;
+
+// everything allocated while reading, so it can be freed if there's an error
+typedef struct module_work {
+  module_sequence *sequence;
+  const char **track_name;
+  uint8_t (*columns)[MODULE_CHANNELS];
+  module_pattern *pattern;
+  module_cell *cell;
+} module_work;
+
+static void free_module_work(module_work *work) {
+  free(work->sequence);
+  free(work->track_name);
+  free(work->columns);
+  free(work->pattern);
+  free(work->cell);
+  free(work);
+}
+
+static const char module_effects[] = ".FBDCE3.HI047PGZ12VYQRASXWHIJHIJ";
+static const char *module_notes[] = {"C-", "C#", "D-", "D#", "E-", "F-", "F#", "G-", "G#", "A-", "A#", "B-"};
+
+int ft2p_is_module(const char *data, size_t length) {
+  return length >= sizeof(MODULE_ID)-1 && !memcmp(data, MODULE_ID, sizeof(MODULE_ID)-1);
+}
+
+static const uint8_t *module_bytes(module_reader *r, size_t length) {
+  if((size_t)(r->end - r->p) < length)
+    error(r->ctx, 1, "The module's %s block ends early", r->block);
+  const uint8_t *bytes = r->p;
+  r->p += length;
+  return bytes;
+}
+
+static int module_char(module_reader *r) {
+  return *module_bytes(r, 1);
+}
+
+static int module_int(module_reader *r) {
+  const uint8_t *b = module_bytes(r, 4);
+  return (int32_t)(b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24);
+}
+
+// reads a zero terminated string, leaving the reader after the zero
+static const char *module_string(module_reader *r) {
+  const uint8_t *start = r->p;
+  while(*module_bytes(r, 1));
+  return (const char*)start;
+}
+
+static module_reader read_block(ft2p_context *ctx, module_block *block, int min_version, int max_version) {
+  if(block->version < min_version || block->version > max_version)
+    error(ctx, 1, "The module's %s block is version %i, which isn't supported", block->name, block->version);
+  module_reader r = {ctx, block->data, block->end, block->name};
+  return r;
+}
+
+static int compare_module_patterns(const void *a, const void *b) {
+  const module_pattern *A = a, *B = b;
+  if(A->track != B->track)
+    return A->track - B->track;
+  if(A->pattern != B->pattern)
+    return A->pattern - B->pattern;
+  return A->channel - B->channel;
+}
+
+// writes the rows of one pattern in the text export's format
+static void emit_module_pattern(ft2p_context *ctx, module_cell *cell, int rows, int channels,
+                                const uint8_t *channel_type, const uint8_t *columns) {
+  static const char hex_digits[] = "0123456789ABCDEF";
+  for(int row=0; row<rows; row++) {
+    emit(ctx, "ROW %02X", row);
+    for(int channel=0; channel<channels; channel++) {
+      module_cell *c = &cell[channel*rows+row];
+      emit_text(ctx, " : ");
+      if(!c->note)
+        emit_text(ctx, "...");
+      else if(c->note == 13)
+        emit_text(ctx, "---");
+      else if(c->note == 14)
+        emit_text(ctx, "===");
+      else if(channel_type[channel] == MODULE_NOISE) {
+        emit_char(ctx, hex_digits[(c->note-1 + c->octave*12) & 15]);
+        emit_text(ctx, "-#");
+      } else {
+        emit_text(ctx, module_notes[c->note-1]);
+        emit_char(ctx, '0' + c->octave % 10);
+      }
+      if(c->instrument < MODULE_NO_INST)
+        emit(ctx, " %02X", c->instrument);
+      else
+        emit_text(ctx, " ..");
+      if(c->volume < MODULE_NO_VOLUME)
+        emit(ctx, " %X", c->volume);
+      else
+        emit_text(ctx, " .");
+      for(int i=0; i<columns[channel]; i++) {
+        if(c->effect[i])
+          emit(ctx, " %c%02X", module_effects[c->effect[i]], c->param[i]);
+        else
+          emit_text(ctx, " ...");
+      }
+    }
+    emit_text(ctx, "\n");
+  }
+  emit_text(ctx, "\n");
+}
+
+// writes every track, with their frames and the patterns that have anything in them
+static void emit_module_tracks(ft2p_context *ctx, module_work *work, module_block *header_block,
+                               module_block *frames_block, module_block *patterns_block, int channels) {
+  module_reader header = read_block(ctx, header_block, 2, 4);
+  int tracks = module_char(&header) + 1;
+  const char **track_name = work->track_name = calloc(tracks, sizeof(*track_name));
+  uint8_t (*columns)[MODULE_CHANNELS] = work->columns = calloc(tracks, sizeof(*columns));
+  uint8_t channel_type[MODULE_CHANNELS];
+  if(!track_name || !columns)
+    error(ctx, 1, "Out of memory");
+  for(int t=0; t<tracks; t++)
+    track_name[t] = header_block->version >= 3 ? module_string(&header) : "New song";
+  for(int i=0; i<channels; i++) {
+    channel_type[i] = module_char(&header);
+    for(int t=0; t<tracks; t++) {
+      columns[t][i] = module_char(&header) + 1;
+      check_range(ctx, "effect column count", columns[t][i], 1, MAX_EFFECTS+1, track_name[t]);
+    }
+  }
+
+  // find each pattern's data first, since the items are read differently depending on the track
+  module_reader patterns = read_block(ctx, patterns_block, 4, 6);
+  int num_patterns = 0, patterns_allocated = 0;
+  while(patterns.p < patterns.end) {
+    work->pattern = grow_array(ctx, work->pattern, &patterns_allocated, num_patterns+1, sizeof(*work->pattern));
+    module_pattern *p = &work->pattern[num_patterns++];
+    p->track = module_int(&patterns);
+    p->channel = module_int(&patterns);
+    p->pattern = module_int(&patterns);
+    p->items = module_int(&patterns);
+    check_range(ctx, "track number", p->track, 0, tracks, NULL);
+    check_range(ctx, "channel number", p->channel, 0, channels, track_name[p->track]);
+    check_range(ctx, "pattern number", p->pattern, 0, MAX_ID, track_name[p->track]);
+    check_range(ctx, "pattern item count", p->items, 0, MAX_ROWS+1, track_name[p->track]);
+    p->data = module_bytes(&patterns, (size_t)p->items * (8 + 2*columns[p->track][p->channel]));
+  }
+  module_pattern *pattern = work->pattern;
+  qsort(pattern, num_patterns, sizeof(*pattern), compare_module_patterns);
+
+  module_reader frames = read_block(ctx, frames_block, 3, 3);
+  module_pattern *next = pattern, *patterns_end = pattern + num_patterns;
+  for(int t=0; t<tracks; t++) {
+    int num_frames = module_int(&frames);
+    int speed = module_int(&frames);
+    int tempo = module_int(&frames);
+    int rows = module_int(&frames);
+    check_range(ctx, "row count", rows, 1, MAX_ROWS+1, track_name[t]);
+    check_range(ctx, "frame count", num_frames, 0, MAX_ID, track_name[t]);
+    emit(ctx, "TRACK %3i %3i %3i \"%s\"\n", rows, speed, tempo, track_name[t]);
+    emit_text(ctx, "COLUMNS :");
+    for(int i=0; i<channels; i++)
+      emit(ctx, " %i", columns[t][i]);
+    emit_text(ctx, "\n\n");
+    for(int f=0; f<num_frames; f++) {
+      emit(ctx, "ORDER %02X :", f);
+      for(int i=0; i<channels; i++)
+        emit(ctx, " %02X", module_char(&frames));
+      emit_text(ctx, "\n");
+    }
+    emit_text(ctx, "\n");
+
+    // fill in each pattern from all of its channels before writing it
+    free(work->cell);
+    module_cell *cell = work->cell = malloc(sizeof(*cell) * channels * rows);
+    if(!cell)
+      error(ctx, 1, "Out of memory");
+    while(next < patterns_end && next->track == t) {
+      int id = next->pattern, used = 0;
+      memset(cell, 0, sizeof(*cell) * channels * rows);
+      for(int i=0; i<channels*rows; i++) {
+        cell[i].instrument = MODULE_NO_INST;
+        cell[i].volume = MODULE_NO_VOLUME;
+      }
+      for(; next < patterns_end && next->track == t && next->pattern == id; next++) {
+        module_reader items = {ctx, next->data, patterns.end, patterns.block};
+        for(int i=0; i<next->items; i++) {
+          int row = module_int(&items);
+          check_range(ctx, "row id", row, 0, rows, track_name[t]);
+          module_cell *c = &cell[next->channel*rows+row];
+          c->note = module_char(&items);
+          c->octave = module_char(&items);
+          c->instrument = module_char(&items);
+          c->volume = module_char(&items);
+          for(int j=0; j<columns[t][next->channel]; j++) {
+            c->effect[j] = module_char(&items);
+            c->param[j] = module_char(&items);
+            if(c->effect[j] && (c->effect[j] >= sizeof(module_effects)-1 || module_effects[c->effect[j]] == '.'))
+              error(ctx, 1, "Unknown effect number %i in the module [%s - pattern %02X row %02X]",
+                    c->effect[j], track_name[t], id, row);
+          }
+          if(c->note > 14)
+            error(ctx, 1, "Unknown note number %i in the module [%s - pattern %02X row %02X]",
+                  c->note, track_name[t], id, row);
+          used = 1;
+        }
+      }
+      if(used) {
+        emit(ctx, "PATTERN %02X\n", id);
+        emit_module_pattern(ctx, cell, rows, channels, channel_type, columns[t]);
+      }
+    }
+  }
+}
+
+char *ft2p_read_module(ft2p_context *ctx, const char *data, size_t length, size_t *text_length) {
+  const uint8_t *p = (const uint8_t*)data, *end = p + length;
+  ctx->out.length = 0;
+  *ctx->error_text = 0;
+  if(!ctx->log.write)
+    ctx->log.write = write_stdout;
+  module_work *work = calloc(1, sizeof(*work));
+  if(!work) {
+    strlcpy(ctx->error_text, "Out of memory", sizeof(ctx->error_text));
+    return NULL;
+  }
+  if(setjmp(ctx->error_jump)) {
+    free_module_work(work);
+    return NULL;
+  }
+  if(!ft2p_is_module(data, length) || length < sizeof(MODULE_ID)-1+4)
+    error(ctx, 1, "Not a Famitracker module");
+
+  // find the blocks that hold anything ft2pently uses; samples and anything newer are skipped
+  const char *names[] = {"PARAMS", "INFO", "HEADER", "INSTRUMENTS", "SEQUENCES", "FRAMES", "PATTERNS", "COMMENTS"};
+  enum {B_PARAMS, B_INFO, B_HEADER, B_INSTRUMENTS, B_SEQUENCES, B_FRAMES, B_PATTERNS, B_COMMENTS, B_COUNT};
+  module_block block[B_COUNT];
+  memset(block, 0, sizeof(block));
+  for(int i=0; i<B_COUNT; i++)
+    block[i].name = names[i];
+  p += sizeof(MODULE_ID)-1+4;
+  while(end-p >= 3 && memcmp(p, "END", 3)) {
+    if(end-p < 24)
+      error(ctx, 1, "The module ends in the middle of a block header");
+    module_reader r = {ctx, p+16, end, "block header"};
+    int version = module_int(&r);
+    uint32_t size = module_int(&r);
+    if(size > (size_t)(end-r.p))
+      error(ctx, 1, "The module's %.16s block ends early", (const char*)p);
+    for(int i=0; i<B_COUNT; i++)
+      if(!strncmp((const char*)p, names[i], 16)) {
+        block[i].data = r.p;
+        block[i].end = r.p + size;
+        block[i].version = version;
+      }
+    p = r.p + size;
+  }
+  for(int i=0; i<B_COUNT; i++)
+    if(!block[i].data && i != B_COMMENTS)
+      error(ctx, 1, "The module has no %s block", names[i]);
+
+  module_reader r = read_block(ctx, &block[B_PARAMS], 2, 7);
+  int expansion = module_char(&r);
+  int channels = module_int(&r);
+  int machine = module_int(&r);
+  int engine_speed = module_int(&r);
+  int vibrato = block[B_PARAMS].version >= 3 ? module_int(&r) : 0;
+  int split = 32;
+  if(block[B_PARAMS].version >= 4)
+    module_bytes(&r, 8); // row highlights
+  if(block[B_PARAMS].version >= 5 && expansion & 16)
+    module_int(&r); // N163 channels
+  if(block[B_PARAMS].version >= 6)
+    split = module_int(&r);
+  check_range(ctx, "channel count", channels, 1, MODULE_CHANNELS+1, NULL);
+
+  emit_text(ctx, "# FamiTracker text export 0.4.2\n\n");
+  r = read_block(ctx, &block[B_INFO], 1, 1);
+  const char *info_names[] = {"TITLE    ", "AUTHOR   ", "COPYRIGHT"};
+  for(int i=0; i<3; i++) {
+    const char *text = (const char*)module_bytes(&r, 32);
+    emit(ctx, "%s       \"%.32s\"\n", info_names[i], text);
+  }
+  emit_text(ctx, "\n");
+
+  // each line of the comment becomes its own COMMENT, as that's where song settings are
+  if(block[B_COMMENTS].data) {
+    r = read_block(ctx, &block[B_COMMENTS], 1, 1);
+    module_int(&r); // whether to show the comment when the module is opened
+    const char *comment = module_string(&r);
+    while(*comment) {
+      size_t line_length = strcspn(comment, "\r\n");
+      emit(ctx, "COMMENT \"%.*s\"\n", (int)line_length, comment);
+      comment += line_length;
+      if(*comment == '\r')
+        comment++;
+      if(*comment == '\n')
+        comment++;
+    }
+    emit_text(ctx, "\n");
+  }
 
-  // write the envelopes the instrument has
-  if(instrument[i][MS_VOLUME] >= 0) {
-    // read the decay information first to find out if the instrument has an automatic decay
-    // (and make a copy of the macro that can be modified without changing the original)
-    ftmacro macro = instrument_macro[MS_VOLUME][num_macro_volume];
-    int decay_rate   = macro.decay_rate;
-    int decay_volume = macro.decay_volume;
-    int decay_index  = macro.decay_index;
-
-    // do not use decay if it would interfere with the arpeggio or duty envelopes, or if disallowed
-    if((decay_rate && decay_enabled && (flags & ALLOW_DECAY))
-                  && (instrument[i][MS_ARPEGGIO] < 0 || ((instrument_macro[MS_ARPEGGIO][num_macro_arp].length < decay_index) && 
-                                                        (instrument_macro[MS_ARPEGGIO][num_macro_arp].loop == -1)))
-                  && (instrument[i][MS_DUTY] < 0 || ((instrument_macro[MS_DUTY][num_macro_duty].length < decay_index) &&
-                                                    (instrument_macro[MS_DUTY][num_macro_duty].loop == -1)))) {
-      // if a decay can be used, cut off the volume envelope at the decay point and write the decay command
-      macro.sequence[decay_index] = decay_volume;
-      macro.length = decay_index + 1;
-      fprintf(file, "  decay %i\r\n", decay_rate);
-    }
-    fprintf(file, "  volume ");
-    write_macro(file, &macro);
-  }
-  if(instrument[i][MS_DUTY] >= 0) {
-    fprintf(file, "  timbre ");
-    write_macro(file, &instrument_macro[MS_DUTY][num_macro_duty]);
-  }
-  if(instrument[i][MS_ARPEGGIO] >= 0) {
-    ftmacro *macro = &instrument_macro[MS_ARPEGGIO][num_macro_arp];
-    fprintf(file, "  pitch ");
+  emit(ctx, "MACHINE %i\nFRAMERATE %i\nEXPANSION %i\nVIBRATO %i\nSPLIT %i\n\n",
+       machine, engine_speed, expansion, vibrato, split);
 
-    if(flags & ABSOLUTE_PITCH) { // Pently sfx pitch envelopes require music notes, not semitone numbers
-      int j;
-      for(j=0; j<macro->length; j++) {
-        if(j == macro->loop)
-          fprintf(file, "| ");
-        // convert to note
-        int semitones = macro->sequence[j];
-        char note;
-        uint8_t octave;
-        semitone_to_note(semitones, &note, &octave);
-        // print it
-        fprintf(file, "%c%s", tolower(note), isupper(note)?"#":"");
-        write_octave(file, octave);
-        fputc(' ', file);
+  // macros; release points and settings are either with each macro or all at the end
+  r = read_block(ctx, &block[B_SEQUENCES], 4, 6);
+  int num_sequences = module_int(&r);
+  check_range(ctx, "macro count", num_sequences, 0, MAX_ID, NULL);
+  module_sequence *sequence = work->sequence = calloc(num_sequences+1, sizeof(*sequence));
+  if(!sequence)
+    error(ctx, 1, "Out of memory");
+  for(int i=0; i<num_sequences; i++) {
+    module_sequence *s = &sequence[i];
+    s->index = module_int(&r);
+    s->type = module_int(&r);
+    s->length = module_char(&r);
+    s->loop = module_int(&r);
+    if(s->loop == s->length) // older Famitracker versions did this for no loop
+      s->loop = -1;
+    s->release = -1;
+    if(block[B_SEQUENCES].version == 4) {
+      s->release = module_int(&r);
+      s->setting = module_int(&r);
+    }
+    s->values = module_bytes(&r, s->length);
+  }
+  if(block[B_SEQUENCES].version == 5) {
+    for(int index=0; index<128; index++)
+      for(int type=0; type<MACRO_SET_COUNT; type++) {
+        int release = module_int(&r), setting = module_int(&r);
+        for(int i=0; i<num_sequences; i++)
+          if(sequence[i].index == index && sequence[i].type == type) {
+            sequence[i].release = release;
+            sequence[i].setting = setting;
+          }
+      }
+  } else if(block[B_SEQUENCES].version == 6) {
+    for(int i=0; i<num_sequences; i++) {
+      sequence[i].release = module_int(&r);
+      sequence[i].setting = module_int(&r);
+    }
+  }
+  for(int i=0; i<num_sequences; i++) {
+    module_sequence *s = &sequence[i];
+    if(!s->length)
+      continue;
+    emit(ctx, "MACRO %i %i %i %i %i :", s->type, s->index, s->loop, s->release, s->setting);
+    for(int j=0; j<s->length; j++)
+      emit(ctx, " %i", (int8_t)s->values[j]);
+    emit_text(ctx, "\n");
+  }
+  emit_text(ctx, "\n");
+
+  // instruments; only 2A03 ones are used, but the simpler expansion ones can be stepped over
+  r = read_block(ctx, &block[B_INSTRUMENTS], 2, 6);
+  int num_instruments = module_int(&r);
+  check_range(ctx, "instrument count", num_instruments, 0, MODULE_NO_INST+1, NULL);
+  for(int i=0; i<num_instruments; i++) {
+    int index = module_int(&r);
+    int type = module_char(&r);
+    int macro[MACRO_SET_COUNT] = {-1, -1, -1, -1, -1};
+    check_range(ctx, "instrument number", index, 0, MODULE_NO_INST, NULL);
+    if(type == 1 || type == 2 || type == 6) { // 2A03, VRC6, Sunsoft 5B
+      int count = module_int(&r);
+      check_range(ctx, "instrument macro count", count, 0, 256, NULL);
+      for(int j=0; j<count; j++) {
+        int enabled = module_char(&r), id = module_char(&r);
+        if(enabled && j < MACRO_SET_COUNT)
+          macro[j] = id;
       }
-      fprintf(file, "\r\n");
+      if(type == 1) // DPCM samples assigned to each key
+        module_bytes(&r, (block[B_INSTRUMENTS].version == 1 ? 6 : 8) * 12 * (block[B_INSTRUMENTS].version > 5 ? 3 : 2));
+    } else if(type == 3) { // VRC7
+      module_bytes(&r, 4 + 8);
     } else {
-      write_macro(file, macro);
+      error(ctx, 1, "Instrument %02X is an FDS or N163 instrument, which can't be read from a module; "
+                    "use a text export instead", index);
     }
+    int name_length = module_int(&r);
+    check_range(ctx, "instrument name length", name_length, 0, 256, NULL);
+    const char *name = (const char*)module_bytes(&r, name_length);
+    if(type == 1)
+      emit(ctx, "INST2A03 %3i %5i %3i %3i %3i %3i \"%.*s\"\n", index,
+           macro[0], macro[1], macro[2], macro[3], macro[4], name_length, name);
   }
+  emit_text(ctx, "\n");
+
+  emit_module_tracks(ctx, work, &block[B_HEADER], &block[B_FRAMES], &block[B_PATTERNS], channels);
+  emit_text(ctx, "# End of export\n");
+
+  free_module_work(work);
+  // the text is handed over, and the converter starts a new output buffer next time
+  char *text = ctx->out.data;
+  *text_length = ctx->out.length;
+  memset(&ctx->out, 0, sizeof(ctx->out));
+  return text;
 }
 
-// converts the number of rows to a Pently note duration
-void write_duration(FILE *file, int duration, int slur) {
-  const char *long_duration[] = {
-    /* 1 */ "16",
-    /* 2 */ "8",
-    /* 3 */ "8 w16",
-    /* 4 */ "4",
-    /* 5 */ "4 w16",
-    /* 6 */ "4 w8",
-    /* 7 */ "4 w8 w16",
-    /* 8 */ "2",
-    /* 9 */ "2 w16",
-    /*10 */ "2 w8",
-    /*11 */ "2 w8 w16",
-    /*12 */ "2 w4",
-    /*13 */ "2 w4 w16",
-    /*14 */ "2 w4 w8",
-    /*15 */ "2 w4 w8 w16",
-    /*16 */ "1"
-  };
-  const char *dotted_duration[] = {
-    /* 1 */ "16",
-    /* 2 */ "8",
-    /* 3 */ "8.",
-    /* 4 */ "4",
-    /* 5 */ "4 w16",
-    /* 6 */ "4.",
-    /* 7 */ "4. w16",
-    /* 8 */ "2",
-    /* 9 */ "2 w16",
-    /*10 */ "2 w8",
-    /*11 */ "2 w8.",
-    /*12 */ "2.",
-    /*13 */ "2. w16",
-    /*14 */ "2. w8",
-    /*15 */ "2. w8.",
-    /*16 */ "1"
-  };
-  const char **durations = dotted_durations ? dotted_duration : long_duration;
+//////////////////// pipelined export ////////////////////
 
-  duration--;
-  fprintf(file, "%s%s ", durations[duration%16], slur?"~":"");
-  while(duration > 16) {
-    fprintf(file, "w1 ");
-    duration -= 16;
+#define MAX_SONG_THREADS 64
+
+// gives a song's automatic dual drums their numbers before it's queued, in the order write_song() comes across
+// them, so that songs written at the same time number them as if they had been written one after another
+// (once the table is full, the song that needs another drum stops with an error when it's written)
+static void number_auto_drums(ft2p_context *ctx, ftsong *xsong) {
+  for(int i=0; i<xsong->patterns_allocated; i++) {
+    if(!get_pattern_used(xsong, i, CH_NOISE))
+      continue;
+    ftpattern *p = xsong->pattern[i];
+    ftnote *notes = p->row[CH_NOISE];
+    int instrument = pattern_instrument(notes, xsong->rows);
+    if(instrument == -1)
+      return; // write_pattern() stops the song here
+    for(int k=0; k<p->events[CH_NOISE] && p->event[CH_NOISE][k].row < p->length[CH_NOISE]; k++) {
+      ftnote *note = &notes[p->event[CH_NOISE][k].row];
+      if(isalnum(note->note) && note->instrument >= 0)
+        instrument = note->instrument;
+      if(!note->note || note->note == '-')
+        continue;
+      if(ctx->num_auto_drums == MAX_AUTO_DRUMS)
+        return;
+      find_auto_drum(ctx, instrument, note->effect[0] == FX_ATTACK_ON ? note->param[0] : 255);
+    }
   }
 }
 
-// write a time in the format "at" takes
-void write_time(FILE *file, int rows) {
-  int measure = rows / 16;
-  int beat    = (rows % 16) / 4;
-  int row     = (rows % 16) % 4;
-
-  fprintf(file, "%i", measure+1);
-  if(beat || row) {
-    fprintf(file, ":%i:%i", beat+1, row);
+// sink that keeps a song's warnings until the parser gets to that song
+static void write_job_log(void *user, const char *data, size_t length) {
+  ft2p_buffer *log = user;
+  if(log->length + length > log->capacity) {
+    size_t capacity = log->capacity ? log->capacity : 256;
+    while(capacity < log->length + length)
+      capacity *= 2;
+    char *grown = realloc(log->data, capacity);
+    if(!grown)
+      return;
+    log->data = grown;
+    log->capacity = capacity;
   }
+  memcpy(log->data + log->length, data, length);
+  log->length += length;
 }
 
-// writes a tempo
-void write_tempo(FILE *file, int speed, int tempo) {
-  float real_tempo = 6;
-  real_tempo /= speed;
-  real_tempo *= tempo;
-  fprintf(file, "  tempo %.2f", real_tempo);
+// render sink that keeps a song's WAV file until the parser gets to that song
+static void write_job_render(void *user, int song_num, const char *name, const char *wav, size_t length) {
+  export_job *job = user;
+  (void)song_num;
+  free(job->wav.data);
+  job->wav.data = malloc(length);
+  job->wav.length = job->wav.capacity = job->wav.data ? length : 0;
+  if(job->wav.data)
+    memcpy(job->wav.data, wav, length);
+  strlcpy(job->name, name, sizeof(job->name));
 }
 
-// writes a pattern to the output file
-void write_pattern(FILE *file, int id, int channel) {
-  // skip over noise channel if auto_noise and auto_dual_drums are both off
-  // skip over DPCM channel if auto_noise or auto_dual_drums are on
-  if((channel == CH_NOISE && !(auto_noise || auto_dual_drums)) ||
-     (channel == CH_DPCM && (auto_noise || auto_dual_drums)))
-    return;
+// with dedup_patterns, songs are written one at a time, each one carrying on with the patterns the last one wrote
+static void move_written_patterns(ft2p_context *to, const ft2p_context *from) {
+  to->num_written_patterns = from->num_written_patterns;
+  to->written_patterns_allocated = from->written_patterns_allocated;
+  to->written_pattern_slots = from->written_pattern_slots;
+  to->written_patterns = from->written_patterns;
+  to->written_pattern_index = from->written_pattern_index;
+  to->patterns_shared = from->patterns_shared;
+  to->patterns_transposed = from->patterns_transposed;
+  to->pattern_bytes_saved = from->pattern_bytes_saved;
+}
 
-  ftnote *pattern = xsong.pattern[id][channel];
-  int i, slur = 0, delay_cut = 0;
+// writes a job's song with its own context; returns 1 if it stopped with an error
+static int write_job_song(export_job *job) {
+  ft2p_context *jc = job->ctx;
+  if(setjmp(jc->error_jump))
+    return 1;
+  write_song(jc, job->song, job->song_num);
+  return 0;
+}
 
-  // find the instrument used for the pattern
-  int instrument = -1;
-  for(i=0; i<xsong.rows; i++)
-    if(pattern[i].instrument >= 0) {
-      instrument = pattern[i].instrument;
+static void *export_thread(void *arg) {
+  ft2p_context *ctx = arg;
+  ft2p_pipeline *p = ctx->pipeline;
+  pthread_mutex_lock(&p->lock);
+  while(1) {
+    while(p->taken == p->queued && !p->finished)
+      pthread_cond_wait(&p->changed, &p->lock);
+    if(p->taken == p->queued)
       break;
-    }
-  if(instrument == -1)
-    error(1, "note with no instrument %s", error_location(&xsong, channel, id, -1));
+    export_job *job = &p->jobs[p->taken++ % p->capacity];
+    ft2p_context *jc = job->ctx;
+    int skip = p->abandon, dedup = jc->options.dedup_patterns || jc->options.transpose_patterns;
+    if(dedup)
+      move_written_patterns(jc, ctx);
+    pthread_mutex_unlock(&p->lock);
 
-  // generate pattern name and specify absolute octaves
-  fprintf(file, "\r\n  pattern pat_%i_%i_%i", song_num, channel, id);
-  if(channel_is_pitched(channel))
-    fprintf(file, " with %s on %s\r\n    absolute", instrument_name[instrument], chan_name[channel]);
-  fprintf(file, "\r\n    ");
+    // after an error, keep taking songs so they get freed, but don't write them
+    int failed = !skip && write_job_song(job);
+    free_song(job->song);
+    job->song = NULL;
 
-  // for each row
-  int row = 0;
-  while(row < xsong.pattern_length[id][channel]) {
-    char this_note = pattern[row].note;
-    int next, octave = pattern[row].octave;
+    pthread_mutex_lock(&p->lock);
+    if(dedup)
+      move_written_patterns(ctx, jc);
+    job->done = 1;
+    job->failed = failed;
+    if(failed) // nothing after this song will be used
+      p->abandon = 1;
+    pthread_cond_broadcast(&p->changed);
+  }
+  pthread_mutex_unlock(&p->lock);
+  return NULL;
+}
 
-    // find the next note
-    for(next = row+1; next < xsong.pattern_length[id][channel]; next++)
-      if(pattern[next].note || pattern[next].volume)
-        break;
-    // the distance between this note and the next note is the duration
-    int duration = next-row;
+static void free_job(export_job *job) {
+  ft2p_context *jc = job->ctx;
+  free(jc->out.data);
+  free(jc->drum_refs);
+  free(jc->costs.pattern);
+  free(jc->instrument_noise);
+  free(jc);
+  free(job->log.data);
+  free(job->wav.data);
+  memset(job, 0, sizeof(*job));
+}
 
-    // write any instrument changes
-    if(isalnum(this_note) && pattern[row].instrument >= 0 && pattern[row].instrument != instrument) {
-      instrument = pattern[row].instrument;
-      if(channel_is_pitched(channel))
-        fprintf(file, "@%s ", instrument_name[instrument]);
+// adds what a song's job wrote to the parser's context; returns 1 if the song stopped with an error
+static int merge_job(ft2p_context *ctx, export_job *job) {
+  ft2p_context *jc = job->ctx;
+  if(jc->num_drum_refs) {
+    ctx->drum_refs = grow_array(ctx, ctx->drum_refs, &ctx->drum_refs_allocated, ctx->num_drum_refs + jc->num_drum_refs, sizeof(ftdrumref));
+    for(int i=0; i<jc->num_drum_refs; i++) {
+      ctx->drum_refs[ctx->num_drum_refs] = jc->drum_refs[i];
+      ctx->drum_refs[ctx->num_drum_refs++].offset += ctx->out.length;
     }
+  }
+  if(jc->out.length)
+    emit_bytes(ctx, jc->out.data, jc->out.length);
+  if(job->log.length)
+    ctx->log.write(ctx->log.user, job->log.data, job->log.length);
+  if(job->wav.length)
+    ctx->render.write(ctx->render.user, job->song_num, job->name, job->wav.data, job->wav.length);
 
-    // write volume changes
-    if(pattern[row].volume) {
-      switch(pattern[row].volume) {
-        case VOL_FF:
-          fprintf(file, "ff ");
-          break;
-        case VOL_MF:
-          fprintf(file, "mf ");
-          break;
-        case VOL_MP:
-          fprintf(file, "mp ");
-          break;
-        case VOL_PP:
-          fprintf(file, "pp ");
-          break;
-      }
+  ft2p_costs *costs = &ctx->costs;
+  if(jc->costs.num_patterns) {
+    costs->pattern = grow_array(ctx, costs->pattern, &costs->patterns_allocated, costs->num_patterns + jc->costs.num_patterns, sizeof(ft2p_pattern_cost));
+    memcpy(costs->pattern + costs->num_patterns, jc->costs.pattern, sizeof(ft2p_pattern_cost) * jc->costs.num_patterns);
+    costs->num_patterns += jc->costs.num_patterns;
+  }
+  for(int i=0; i<jc->costs.num_songs && costs->num_songs < MAX_SONGS; i++)
+    costs->song[costs->num_songs++] = jc->costs.song[i];
+  for(int i=0; i<PHASE_COUNT; i++)
+    ctx->stats.seconds[i] += jc->stats.seconds[i];
+  ctx->stats.notes += jc->stats.notes;
+  ctx->stats.patterns_written += jc->stats.patterns_written;
+  ctx->stats.patterns_empty += jc->stats.patterns_empty;
+  ctx->stats.songs_cached += jc->stats.songs_cached;
+  for(int i=0; i<jc->instruments_allocated && i<ctx->instruments_allocated; i++)
+    ctx->instrument_noise[i] |= jc->instrument_noise[i];
+  ctx->pieces_factored += jc->pieces_factored;
+  ctx->pieces_shared += jc->pieces_shared;
+  ctx->factor_bytes_saved += jc->factor_bytes_saved;
+
+  int failed = job->failed;
+  if(failed)
+    strlcpy(ctx->error_text, jc->error_text, sizeof(ctx->error_text));
+  free_job(job);
+  return failed;
+}
+
+// merges songs that are done, in the order they were queued, until no more than "keep" are left in the pipeline;
+// if one of them stopped with an error, the parser stops too
+static void pipeline_merge(ft2p_context *ctx, int keep) {
+  ft2p_pipeline *p = ctx->pipeline;
+  pthread_mutex_lock(&p->lock);
+  while(p->merged < p->queued) {
+    export_job *job = &p->jobs[p->merged % p->capacity];
+    if(!job->done) {
+      if(p->queued - p->merged <= keep)
+        break;
+      pthread_cond_wait(&p->changed, &p->lock);
+      continue;
     }
+    // only the parser queues jobs, so the slot stays put while it's merged
+    p->merged++;
+    pthread_mutex_unlock(&p->lock);
+    p->failed = merge_job(ctx, job);
+    if(p->failed)
+      longjmp(ctx->error_jump, 1);
+    pthread_mutex_lock(&p->lock);
+  }
+  pthread_mutex_unlock(&p->lock);
+}
 
-    // handle any effects
-    for(i=0; i<MAX_EFFECTS; i++) {
-      switch(pattern[row].effect[i]) {
-        case FX_SLUR:
-          slur = pattern[row].param[i] != 0;
-          break;
-        case FX_ARP:
-          if(channel_is_pitched(channel))
-            fprintf(file, "EN%.2x ", pattern[row].param[i]);
-          break;
-        case FX_VIBRATO:
-          if(channel_is_pitched(channel)) {
-            switch(pattern[row].param[i] & 15) {
-              case 0:
-                fprintf(file, "MP0 ");
-                break;
-              case 1: case 2:
-                fprintf(file, "MP1 ");
-                break;
-              case 3: case 4:
-                fprintf(file, "MP2 ");
-                break;
-              case 5: case 6:
-                fprintf(file, "MP3 ");
-                break;
-              default:
-                fprintf(file, "MP4 ");
-                break;
-            }
-          }
-          break;
-        case FX_DELAYCUT:
-          if(this_note) {
-            delay_cut = pattern[row].param[i];
-            break;
-          }
-          // if it's an empty row, turn it into a delay and insert a note cut right here instead of at the next note
-          pattern[row].note = '-';
-        case FX_DELAY:
-          fprintf(file, "r%ig ", pattern[row].param[i]);
-          break;
-      }
+// starts the exporter threads: as many as song_threads asks for, but only one if songs share patterns,
+// as those have to be written in order
+static ft2p_pipeline *pipeline_start(ft2p_context *ctx) {
+  int exporters = ctx->options.song_threads > 1 ? ctx->options.song_threads : 1;
+  if(exporters > MAX_SONG_THREADS)
+    exporters = MAX_SONG_THREADS;
+  if(ctx->options.dedup_patterns || ctx->options.transpose_patterns)
+    exporters = 1;
+  ft2p_pipeline *p = calloc(1, sizeof(ft2p_pipeline));
+  if(p) {
+    p->capacity = exporters + PIPELINE_QUEUE;
+    p->exporter = calloc(exporters, sizeof(pthread_t));
+    p->jobs = calloc(p->capacity, sizeof(export_job));
+  }
+  if(!p || !p->exporter || !p->jobs) {
+    if(p) {
+      free(p->exporter);
+      free(p->jobs);
     }
+    free(p);
+    error(ctx, 1, "Out of memory");
+  }
+  pthread_mutex_init(&p->lock, NULL);
+  pthread_cond_init(&p->changed, NULL);
+  ctx->pipeline = p;
+  // make do with however many threads could be started
+  while(p->exporters < exporters && !pthread_create(&p->exporter[p->exporters], NULL, export_thread, ctx))
+    p->exporters++;
+  if(!p->exporters) {
+    ctx->pipeline = NULL;
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->changed);
+    free(p->exporter);
+    free(p->jobs);
+    free(p);
+    error(ctx, 1, "Couldn't start the exporter thread");
+  }
+  return p;
+}
 
-    // write note
-    if(this_note == '-') { // note cut
-        fprintf(file, "r");
-    } else if(!this_note) { // no not
-        fprintf(file, "w");
-    } else if(channel_is_pitched(channel)) { // a note
-      // just write normal notes
-      fprintf(file, "%c%s", tolower(this_note), isupper(this_note)?"#":"");
+// queues a finished song for the exporters, starting them if needed
+void pipeline_push(ft2p_context *ctx, ftsong *song, int song_num) {
+  ft2p_pipeline *p = ctx->pipeline;
+  if(!p)
+    p = pipeline_start(ctx);
+  if(ctx->options.auto_dual_drums)
+    number_auto_drums(ctx, song);
+  pipeline_merge(ctx, p->capacity-1); // makes room for it
 
-      // shift the octave in the direction needed
-      write_octave(file, octave);
-    } else if(channel == CH_NOISE) { // noise
-      if(auto_dual_drums) { // auto_dual_drums
-        uint8_t noise = instrument;
-        uint8_t triangle = 255; // default to no triangle part
-        if(pattern[row].effect[0] == FX_ATTACK_ON) { // repurposed effect
-          triangle = pattern[row].param[0];
-        }
-        uint8_t drum_no = find_auto_drum(noise, triangle);
-        fprintf(file, "autodrum%i_", drum_no);
-      } else { // auto_noise
-        // for noise, use the instrument name and the note frequency
+  ft2p_context *jc = malloc(sizeof(ft2p_context));
+  uint16_t *noise = malloc(sizeof(uint16_t) * (ctx->instruments_allocated ? ctx->instruments_allocated : 1));
+  if(!jc || !noise) {
+    free(jc);
+    free(noise);
+    error(ctx, 1, "Out of memory");
+  }
 
-        // mark frequency as being used
-        char hex[2] = {this_note, 0};
-        instrument_noise[instrument] |= 1 << strtol(hex, NULL, 16);
+  // the song is written with a copy of the parser's context, which shares the instrument tables (which don't change
+  // until the pipeline is synced), and starts out empty in everything that writing a song adds to;
+  // the copy is made under the lock since with dedup_patterns, an exporter may be moving the written patterns
+  pthread_mutex_lock(&p->lock);
+  *jc = *ctx;
+  memcpy(noise, ctx->instrument_noise, sizeof(uint16_t) * ctx->instruments_allocated);
+  jc->instrument_noise = noise;
+  jc->pipeline = NULL;
+  jc->song = jc->xsong = NULL;
+  jc->last_line = NULL;
+  memset(&jc->out, 0, sizeof(jc->out));
+  jc->num_drum_refs = jc->drum_refs_allocated = 0;
+  jc->drum_refs = NULL;
+  memset(&jc->ca65_table, 0, sizeof(jc->ca65_table));
+  jc->costs.num_songs = jc->costs.num_patterns = jc->costs.patterns_allocated = 0;
+  jc->costs.pattern = NULL;
+  memset(&jc->stats, 0, sizeof(jc->stats));
+  jc->pieces_factored = jc->pieces_shared = jc->factor_bytes_saved = 0;
+  export_job *job = &p->jobs[p->queued++ % p->capacity];
+  *job = (export_job){.song = song, .song_num = song_num, .ctx = jc};
+  jc->log.write = write_job_log;
+  jc->log.user = &job->log;
+  if(ctx->render.write) {
+    jc->render.write = write_job_render;
+    jc->render.user = job;
+  }
+  ctx->xsong = NULL; // the job owns the song from here on
+  pthread_cond_broadcast(&p->changed);
+  pthread_mutex_unlock(&p->lock);
+}
 
-        fprintf(file, "%s_%c_", instrument_name[instrument], this_note);
-      }
-    } else { // DPCM
-      // for DPCM: write drum name
-      char *scale_note = strchr(scale, this_note);
-      fprintf(file, "%s", drum_name[octave][scale_note-scale]);
-    }
-    if(delay_cut && isalpha(this_note)) {
-      fprintf(file, "%ig r", delay_cut);
-      delay_cut = 0;
-    }
-    write_duration(file, duration, slur|pattern[row].slur);
+// waits until every queued song has been written and merged, so the parser can write output or change shared state
+void pipeline_sync(ft2p_context *ctx) {
+  pipeline_merge(ctx, 0);
+}
 
-    row = next;
+// shuts down the exporter threads once they're done with the queue; after an error, songs that were queued before it
+// still go into the output, as they would have been written before the error, up to the first song that failed
+static void pipeline_stop(ft2p_context *ctx) {
+  ft2p_pipeline *p = ctx->pipeline;
+  if(!p)
+    return;
+  pthread_mutex_lock(&p->lock);
+  p->finished = 1;
+  pthread_cond_broadcast(&p->changed);
+  pthread_mutex_unlock(&p->lock);
+  for(int i=0; i<p->exporters; i++)
+    pthread_join(p->exporter[i], NULL);
+  ctx->pipeline = NULL;
+  for(; p->merged < p->queued; p->merged++) {
+    export_job *job = &p->jobs[p->merged % p->capacity];
+    if(p->failed)
+      free_job(job);
+    else
+      p->failed = merge_job(ctx, job);
   }
+  pthread_mutex_destroy(&p->lock);
+  pthread_cond_destroy(&p->changed);
+  free(p->exporter);
+  free(p->jobs);
+  free(p);
+}
 
+// frees everything a conversion allocated
+static void free_conversion(ft2p_context *ctx) {
+  free_song(ctx->song);
+  if(ctx->xsong != ctx->song)
+    free_song(ctx->xsong);
+  ctx->song = ctx->xsong = NULL;
+  for(int i=0; i<ctx->num_written_patterns; i++)
+    free(ctx->written_patterns[i].text);
+  ctx->num_written_patterns = 0;
+  ctx->patterns_shared = ctx->patterns_transposed = 0;
+  ctx->pattern_bytes_saved = 0;
+  ctx->pieces_factored = ctx->pieces_shared = ctx->factor_bytes_saved = 0;
+  ctx->costs.instruments = ctx->costs.sfx = ctx->costs.drums = ctx->costs.total = 0;
+  ctx->costs.num_songs = ctx->costs.num_patterns = 0;
+  ctx->instruments_merged = 0;
+  memset(&ctx->stats, 0, sizeof(ctx->stats));
+  ctx->global_hash = FT2P_HASH_START;
 }
 
-int main(int argc, char *argv[]) {
+void ft2p_free(ft2p_context *ctx) {
+  if(!ctx)
+    return;
+  free_conversion(ctx);
+  free(ctx->instrument);
+  free(ctx->instrument_used);
+  free(ctx->instrument_ignore);
+  free(ctx->instrument_name);
+  free(ctx->instrument_noise);
+  free(ctx->instrument_alias);
+  for(int i=0; i<MACRO_SET_COUNT; i++)
+    free(ctx->instrument_macro[i]);
+  free(ctx->written_patterns);
+  free(ctx->written_pattern_index);
+  free(ctx->symbols);
+  free(ctx->symbol_index);
+  free(ctx->drum_refs);
+  free(ctx->costs.pattern);
+  for(int i=0; i<CA65_TABLE_COUNT; i++)
+    free(ctx->ca65_table[i].data);
+  free(ctx->out.data);
+  free(ctx->last_line);
+  free(ctx);
+}
+
+// puts the module state back to how it is before reading any file
+static void reset_context(ft2p_context *ctx) {
+  ctx->song_num = 0;
+  ctx->sfx_num = 0;
+  ctx->num_auto_drums = 0;
+  ctx->num_drums = ctx->num_drum_refs = 0;
+  ctx->duplicate_name_counter = 0;
+  // keep the tables that were allocated by the last conversion, but empty them
+  ctx->num_instruments = 0;
+  if(ctx->instruments_allocated) {
+    int count = ctx->instruments_allocated;
+    memset(ctx->instrument, 0, sizeof(*ctx->instrument)*count);
+    memset(ctx->instrument_used, 0, sizeof(*ctx->instrument_used)*count);
+    memset(ctx->instrument_ignore, 0, sizeof(*ctx->instrument_ignore)*count);
+    memset(ctx->instrument_name, 0, sizeof(*ctx->instrument_name)*count);
+    memset(ctx->instrument_noise, 0, sizeof(*ctx->instrument_noise)*count);
+  }
+  for(int i=0; i<MACRO_SET_COUNT; i++) {
+    ctx->num_macros[i] = 0;
+    if(ctx->macros_allocated[i])
+      memset(ctx->instrument_macro[i], 0, sizeof(ftmacro)*ctx->macros_allocated[i]);
+  }
+  memset(&ctx->drum_name, 0, sizeof(ctx->drum_name));
+  memset(&ctx->auto_drum_noise, 255, sizeof(ctx->auto_drum_noise));
+  memset(&ctx->auto_drum_tri,   255, sizeof(ctx->auto_drum_tri));
+  ctx->num_symbols = 0;
+  if(ctx->symbol_slots)
+    memset(ctx->symbol_index, 0xff, sizeof(int)*ctx->symbol_slots);
+  memset(&ctx->soundeffects, 0, sizeof(ctx->soundeffects));
+  free_conversion(ctx);
+  ctx->out.length = 0;
+  for(int i=0; i<CA65_TABLE_COUNT; i++)
+    ctx->ca65_table[i].length = 0;
+  if(ctx->written_pattern_slots)
+    memset(ctx->written_pattern_index, 0xff, sizeof(int)*ctx->written_pattern_slots);
+  *ctx->error_text = 0;
+}
+
+int ft2p_convert(ft2p_context *ctx, char *input, size_t length, const ft2p_sink *output, const ft2p_options *options) {
   int i, j;
-  char buffer[700];
-  memset(&instrument, 0, sizeof(instrument));
-  memset(&instrument_used, 0, sizeof(instrument_used));
-  memset(&instrument_ignore, 0, sizeof(instrument_ignore));
-  memset(&instrument_macro, 0, sizeof(instrument_macro));
-  memset(&instrument_name, 0, sizeof(instrument_name));
-  memset(&instrument_noise, 0, sizeof(instrument_noise));
-  memset(&drum_name, 0, sizeof(drum_name));
-  memset(&auto_drum_noise, 255, sizeof(auto_drum_noise));
-  memset(&auto_drum_tri,   255, sizeof(auto_drum_tri));
-  memset(&song_name, 0, sizeof(song_name));
-  memset(&soundeffects, 0, sizeof(soundeffects));
-
-  // Generate decay tables
-  for(i=0;i<MAX_DECAY_START;i++) {
-    for(j=0;j<MAX_DECAY_RATE;j++) {
-      int volume = (i+1)<<4;
-      int value, index = 0, decay = j+1;
-            
-      while(volume >= 0x08) {
-        volume -= decay;
-        value = ((volume+8)>>4);
-        decay_envelope[i][j][index++] = value;
-      }
-      if(value != 0)
-        decay_envelope[i][j][index++] = 0;
-    }
-  }
-
-  // read arguments
-  for(i=1; i<argc; i++) {
-    if(!strcmp(argv[i], "-i"))
-      in_filename = argv[i+1];
-    if(!strcmp(argv[i], "-o"))
-      out_filename = argv[i+1];
-    if(!strcmp(argv[i], "-strict"))
-      strict = 1;
-    if(!strcmp(argv[i], "-hexrow"))
-      hex_rows = 1;
-    if(!strcmp(argv[i], "-dotted"))
-      dotted_durations = 1;
-    if(!strcmp(argv[i], "-autonoise"))
-      auto_noise = 1;
-    if(!strcmp(argv[i], "-autodualdrums"))
-      auto_dual_drums = 1;
-    if(!strcmp(argv[i], "-autodecay"))
-      decay_enabled = 1;
-  }
-
-  // complain if input or output not specified
-  if(!in_filename || !out_filename) {
-    puts("syntax: ft2p -i input -o output");
-    exit(-1);
-  }
-
-  // start reading file
-  FILE *input_file = fopen(in_filename, "rb");
-  if(!input_file)
-    error(1,"Input file couldn't be opened");
-  FILE *output_file = fopen(out_filename, "wb");
-  if(!output_file)
-    error(1,"Output file couldn't be opened");
-  fprintf(output_file, "durations stick\r\nnotenames english\r\n");
+  char *cursor = input, *input_end = input+length;
+
+  reset_context(ctx);
+  if(options)
+    ctx->options = *options;
+  else
+    memset(&ctx->options, 0, sizeof(ctx->options));
+  if(output)
+    ctx->output = *output;
+  else
+    memset(&ctx->output, 0, sizeof(ctx->output));
+  if(!ctx->log.write)
+    ctx->log.write = write_stdout;
+
+  if(ctx->options.stats)
+    ctx->stats.total = ctx->stats.mark = seconds_now();
+
+  // error() comes back here if the conversion can't continue
+  if(setjmp(ctx->error_jump)) {
+    pipeline_stop(ctx);
+    finish_stats(ctx);
+    flush_output(ctx); // still write what was converted before the error
+    return -1;
+  }
+
+  // there's always a song to parse into, even before the first TRACK
+  ftsong *song = ctx->song = new_song(ctx);
+  ftsong *xsong = NULL;
+  // instruments that are used without being defined point at the first macro of every type
+  for(i=0; i<MACRO_SET_COUNT; i++)
+    need_macro(ctx, i, 0);
+  if(ctx->options.ca65 && (ctx->options.dedup_patterns || ctx->options.transpose_patterns || ctx->options.factor_patterns))
+    error(ctx, 1, "patterns can't be shared in ca65 output");
+  if(ctx->options.ca65)
+    emit_text(ctx, ".include \"pentlyseq.inc\"\r\n.segment \"RODATA\"\r\n");
+  else
+    emit_text(ctx, "durations stick\r\nnotenames english\r\n");
 
   // process each line
   int need_song_export = 0;
   while(1) {
-    int end_of_file = fgets(buffer, sizeof(buffer), input_file) == NULL;
+    char empty_line[1] = {0}, *line_end;
+    char *buffer = next_line(ctx, &cursor, input_end, &line_end);
+    int end_of_file = buffer == NULL;
     if(end_of_file) // Run through the code with an empty line buffer
-      *buffer = 0;
+      buffer = line_end = empty_line;
+
+    // with a song cache, every line goes into the key of either the song it's part of or everything else
+    uint64_t line_hash = ctx->song_cache.load ? ft2p_hash(FT2P_HASH_START, buffer, line_end-buffer) : 0;
 
-    char *arg;
-    remove_line_endings(buffer);
+    char *arg = NULL;
+    int keyword = find_keyword(buffer, &arg);
+    enter_phase(ctx, (keyword == KW_MACRO || keyword == KW_INST2A03) ? PHASE_MACROS : PHASE_PARSE);
+    if(!end_of_file)
+      ctx->stats.lines++;
+    // strip the closing quote off of lines that end with a string
+    if(keyword != KW_ROW && keyword != KW_MACRO && keyword != KW_NONE)
+      remove_line_ending(buffer, '\"');
+    // anything outside of a song's own data has to wait for the exporter to catch up
+    if(ctx->pipeline && (end_of_file || (keyword != KW_TRACK && keyword != KW_COLUMNS && keyword != KW_ORDER
+                                         && keyword != KW_PATTERN && keyword != KW_ROW && keyword != KW_NONE))) {
+      pipeline_sync(ctx);
+      if(end_of_file)
+        pipeline_stop(ctx);
+    }
 
-    if(starts_with(buffer, "TRACK ", &arg)) {
-      if(song_num) {
-        // copy song to xsong, because song is going to be reset for the new track
+    if(keyword == KW_TRACK) {
+      // instruments are all defined before the first track, so they can be compared now
+      if(!ctx->song_num && ctx->options.merge_instruments) {
+        enter_phase(ctx, PHASE_MACROS);
+        merge_instruments(ctx);
+        enter_phase(ctx, PHASE_PARSE);
+      }
+      if(ctx->song_num) {
+        // hand the finished song over to be exported, because a new one is going to be started for the new track
         need_song_export = 1;
-        xsong = song;
+        xsong = ctx->xsong = song;
+      } else {
+        free_song(song);
       }
-      song_num++;
-      memset(&song, 0, sizeof(song));
-      song.rows = strtol(arg, &arg, 10);
-      for(i=0; i<MAX_PATTERNS; i++)
-        for(j=0; j<CHANNEL_COUNT; j++)
-          song.pattern_length[i][j] = song.rows;
-      song.speed = strtol(arg, &arg, 10);
-      song.tempo = strtol(arg, &arg, 10);
+      ctx->song_num++;
+      check_range(ctx, "number of songs", ctx->song_num, 1, MAX_SONGS+1, NULL);
+      song = ctx->song = new_song(ctx);
+      song->rows = strtol(arg, &arg, 10);
+      check_range(ctx, "row count", song->rows, 0, MAX_ROWS+1, NULL);
+      song->speed = strtol(arg, &arg, 10);
+      song->tempo = strtol(arg, &arg, 10);
       arg = strchr(arg, '\"');
 
-      strlcpy(song.real_name, arg+1, sizeof(song.real_name));
-      sanitize_name(song.name, arg+1, sizeof(song.name));
-      strlcpy(song_name[song_num-1], song.name, SONG_NAME_LEN);
+      strlcpy(song->real_name, arg+1, sizeof(song->real_name));
+      sanitize_name(song->name, arg+1, sizeof(song->name));
 
       // check for and fix duplicate song names
-      for(i=0;i<song_num-1;i++) {
-        if(!strcmp(song.name, song_name[i])) {
-          sprintf(buffer, "%s__%i", song.name, duplicate_name_counter++);
-          error(0, "Duplicate song name (%s), renaming to \"%s\"", song.name, buffer);
-          strlcpy(song.name, buffer, sizeof(song.name));
-          break;
-        }
+      if(intern_symbol(ctx, SYMBOL_SONG, song->name, NULL)) {
+        char renamed[SONG_NAME_LEN+16];
+        sprintf(renamed, "%s__%i", song->name, ctx->duplicate_name_counter++);
+        error(ctx, 0, "Duplicate song name (%s), renaming to \"%s\"", song->name, renamed);
+        strlcpy(song->name, renamed, sizeof(song->name));
+        intern_symbol(ctx, SYMBOL_SONG, song->name, NULL);
       }
     }
 
-    else if(starts_with(buffer, "PATTERN ", &arg)) {
-      song.pattern_id = strtol(arg, NULL, 16);
-      check_range("pattern id", song.pattern_id, 0, MAX_PATTERNS, song.real_name);
+    else if(keyword == KW_PATTERN) {
+      song->pattern_id = strtol(arg, NULL, 16);
+      need_pattern(ctx, song, song->pattern_id);
+      for(i=0; i<CHANNEL_COUNT; i++)
+        song->channel_state[i].next_row = 0;
     }
 
-    else if(starts_with(buffer, "ROW ", &arg)) {
+    else if(keyword == KW_ROW) {
+      ctx->stats.rows++;
       int row = strtol(arg, &arg, 16);
-      check_range("row id", row, 0, MAX_ROWS, error_location(&song, 0, song.pattern_id, -1));
+      check_range(ctx, "row id", row, 0, song->rows, error_location(ctx, song, 0, song->pattern_id, -1));
+      ftpattern *pattern = need_pattern(ctx, song, song->pattern_id);
 
+      char *line = strchr(arg, ':');
       for(int channel=0; channel<CHANNEL_COUNT; channel++) {
-         // find next channel
-         arg = strchr(arg, ':');
-         if(!arg)
+         // find next channel, which should start right after the previous channel's last effect column
+         if(channel) {
+           char *next = line + 11 + 4*song->effect_columns[channel-1];
+           line = (next < line_end && *next == ':') ? next : strchr(line+1, ':');
+         }
+         if(!line)
            break;
-         char *line = arg;
-         arg++;
+         ftnote *notes = pattern->row[channel];
+         ftchannel_state *state = decode_up_to(&song->channel_state[channel], notes, row);
 
-         // skip if the note is already filled in
-         if(song.pattern[song.pattern_id][channel][row].note) {
-           puts("skipping");
+         // skip if the note is already filled in (by a Qxy or Rxy slide on the row before, or a repeated row)
+         if(notes[row].note)
            continue;
-         }
 
          // read note info
          ftnote note;
          memset(&note, 0, sizeof(note));
- 
+
          note.instrument = -1;
 
          // volume column
          if(line[9] != '.') {
            int volume = VOL_SAME;
-           int digit = strtol(line+9, NULL, 16);
+           int digit = read_hex(line+9, 1);
            if(digit <= 6)
              volume = VOL_PP;
            else if(digit <= 9)
@@ -799,13 +4273,7 @@ int main(int argc, char *argv[]) {
              volume = VOL_MF;
            else
              volume = VOL_FF;
-           int last_volume = VOL_SAME;
-           for(j=row-1; j>=0; j--)
-             if(song.pattern[song.pattern_id][channel][j].volume) {
-               last_volume = song.pattern[song.pattern_id][channel][j].volume;
-               break;
-             }
-           if(volume != last_volume)    
+           if(volume != state->last_volume)
              note.volume = volume;
          }
 
@@ -822,39 +4290,36 @@ int main(int argc, char *argv[]) {
 
            // read instrument if it's there
            if(isalnum(note.note) && line[6] != '.') {
-             int read_instrument = strtol(line+6, NULL, 16);
-             if(read_instrument < 0 || read_instrument >= MAX_INSTRUMENTS) {
-               error(0, "instrument (%i) out of range - %s", read_instrument, error_location(&song, channel, song.pattern_id, row));
-               // skip this note altogether
-               continue;
+             int read_instrument = read_hex(line+6, 2);
+             if(read_instrument != -1) {
+               need_instrument(ctx, read_instrument);
+               read_instrument = ctx->instrument_alias[read_instrument];
              }
              // mark used if the note's not ignored (I should just probably actually bail out of parsing the note if it's ignored)
-             if(channel_is_pitched(channel) && !(read_instrument != -1 && instrument_ignore[read_instrument] & (1 << channel)))
-               instrument_used[read_instrument] = 1;
+             if(channel_is_pitched(channel) && !(read_instrument != -1 && ctx->instrument_ignore[read_instrument] & (1 << channel)))
+               ctx->instrument_used[read_instrument] = 1;
              note.instrument = read_instrument;
-           } else { // if it's not, go back and find it
-             for(j=row-1; j>=0; j--)
-               if(song.pattern[song.pattern_id][channel][j].note && (song.pattern[song.pattern_id][channel][j].instrument != -1)) {
-                 note.instrument = song.pattern[song.pattern_id][channel][j].instrument;
-                 break;
-               }
+           } else { // if it's not, use the last one
+             note.instrument = state->last_instrument;
            }
          }
 
          // read effects
-         for(j=0; j<song.effect_columns[channel]; j++) {
+         int effects = 0;
+         for(j=0; j<song->effect_columns[channel]; j++) {
            // read in the effect type and value
            char *effect = line+11+4*j;
+           effects |= *effect != '.';
            if(!strchr(supported_effects, *effect))
-             error(0, "unsupported effect (%c) %s", *effect, error_location(&song, channel, song.pattern_id, row));
+             error(ctx, 0, "unsupported effect (%c) %s", *effect, error_location(ctx, song, channel, song->pattern_id, row));
            note.effect[j] = *effect;
-           note.param[j]  = strtol(effect+1, NULL, 16);
+           note.param[j]  = read_hex(effect+1, 2);
 
            // some effects call for processing during pattern reading
-           ftnote *next_note = &song.pattern[song.pattern_id][channel][row+1];
+           ftnote *next_note = &notes[row+1];
            switch(*effect) {
              case FX_DELAYCUT:
-               if((tri_sxx_to_cut && channel == CH_TRIANGLE) || !note.param[j]) {
+               if((ctx->options.tri_sxx_to_cut && channel == CH_TRIANGLE) || !note.param[j]) {
                  // S00 is identical to a note cut
                  // also cut if using tri_sxx_to_cut
                  note.note = '-';
@@ -862,70 +4327,69 @@ int main(int argc, char *argv[]) {
                }
                break;
              case FX_SLUR:
-               if(note.param[j]) // set slur on previous note
-                 for(int k=row-1; k >= 0; k--) // find previous note
-                   if(song.pattern[song.pattern_id][channel][k].note) {
-                     song.pattern[song.pattern_id][channel][k].slur = 1;
-                     break;
-                   }
+               if(note.param[j] && state->last_note >= 0) // set slur on previous note
+                 notes[state->last_note].slur = 1;
                break;
              // mark the note as a slur and make the note to slur into
              case FX_SLUR_UP:
                note.slur = 1;
                *next_note = make_note(note.octave, note.note, note.instrument);
                shift_semitones(next_note, note.param[j]&15);
+               mark_filled(pattern, channel, row+1);
                break;
              case FX_SLUR_DN:
                note.slur = 1;
                *next_note = make_note(note.octave, note.note, note.instrument);
                shift_semitones(next_note, -(note.param[j]&15));
+               mark_filled(pattern, channel, row+1);
                break;
              // loops, pattern cuts and fines all reduce the length of the pattern
              case FX_LOOP:
-               song.loop_to = note.param[j];
+               song->loop_to = note.param[j];
                goto pattern_cut;
              case FX_FINE:
-               song.loop_to = -1;
+               song->loop_to = -1;
              case FX_PAT_CUT:
              pattern_cut:
-               song.pattern_length[song.pattern_id][channel] = row+1;
+               pattern->length[channel] = row+1;
            }
          }
 
          // write the note only if the instrument is not ignored
-         if(!(note.instrument != -1 && instrument_ignore[note.instrument] & (1 << channel))) {
+         if(!(note.instrument != -1 && ctx->instrument_ignore[note.instrument] & (1 << channel))) {
            // finally write the note we made into the pattern
-           song.pattern[song.pattern_id][channel][row] = note;
+           notes[row] = note;
+           if(note.note || note.volume || effects)
+             mark_filled(pattern, channel, row);
          }
       }
 
     }
 
-    else if(starts_with(buffer, "TITLE ", &arg)) {
+    else if(keyword == KW_TITLE) {
       char *temp = strchr(arg, '\"');
       if(temp) {
         arg = temp+1;
       }
-      fprintf(output_file, "\r\ntitle %s", arg);
+      emit(ctx, ctx->options.ca65 ? "\r\n; title %s" : "\r\ntitle %s", arg);
 	}
-    else if(starts_with(buffer, "AUTHOR ", &arg)) {
+    else if(keyword == KW_AUTHOR) {
       char *temp = strchr(arg, '\"');
       if(temp) {
         arg = temp+1;
       }
-      fprintf(output_file, "\r\nauthor %s", arg);
+      emit(ctx, ctx->options.ca65 ? "\r\n; author %s" : "\r\nauthor %s", arg);
 	}
-    else if(starts_with(buffer, "COPYRIGHT ", &arg)) {
+    else if(keyword == KW_COPYRIGHT) {
       char *temp = strchr(arg, '\"');
       if(temp) {
         arg = temp+1;
       }
-      fprintf(output_file, "\r\ncopyright %s\r\n", arg);
+      emit(ctx, ctx->options.ca65 ? "\r\n; copyright %s\r\n" : "\r\ncopyright %s\r\n", arg);
 	}
 
     // comments are used for song metadata
-    else if(starts_with(buffer, "COMMENT ", &arg)) {
-      remove_line_ending(buffer, '\r');
+    else if(keyword == KW_COMMENT) {
       if(*arg == '\"')
         arg++;
       char *arg2;
@@ -936,43 +4400,51 @@ int main(int argc, char *argv[]) {
         // separate the channel name and instrument ID
         char *space = strchr(arg2, ' ');
         if(!space)
-          error(1, "'ignore' takes two parameters");
+          error(ctx, 1, "'ignore' takes two parameters");
         *space = 0;
         space = skip_to_number(space+1);
         if(!isxdigit(*space))
-          error(1, "'ignore' needs an instrument number in hex");
+          error(ctx, 1, "'ignore' needs an instrument number in hex");
         instrument_id = strtol(space, NULL, 16);
 
         while(strcmp(chan_name[channel_id], arg2) && channel_id != CHANNEL_COUNT)
           channel_id++;
         if(channel_id == CHANNEL_COUNT)
-          error(1, "'ignore' needs a channel name; use pulse1, pulse2, triangle, noise, drum, or attack");
+          error(ctx, 1, "'ignore' needs a channel name; use pulse1, pulse2, triangle, noise, drum, or attack");
 
-        printf("ignoring %x on %s\n", instrument_id, chan_name[channel_id]);
-        instrument_ignore[instrument_id] |= 1 << channel_id;
+        log_printf(ctx, "ignoring %x on %s\n", instrument_id, chan_name[channel_id]);
+        need_instrument(ctx, instrument_id);
+        ctx->instrument_ignore[instrument_id] |= 1 << channel_id;
       }
       if(starts_with(arg, "include ", &arg2)) {
         // import another file into this file
+        enter_phase(ctx, PHASE_INCLUDE);
+        if(ctx->options.ca65) { // ca65 output includes ca65 source, which the assembler reads itself
+          emit(ctx, ".include \"%s\"\r\n", arg2);
+          continue;
+        }
         FILE *included = fopen(arg2, "rb");
         if(!included)
-          error(1,"couldn't open included file \"%s\"", arg2);
-        while(!feof(included)) {
-          char c = fgetc(included);
-          if(c != EOF)
-            fputc(c, output_file);
-        }
+          error(ctx, 1,"couldn't open included file \"%s\"", arg2);
+        size_t got;
+        do {
+          got = fread(reserve_output(ctx, 4096), 1, 4096, included);
+          ctx->out.length += got;
+        } while(got == 4096);
         fclose(included);
       } else if(!strcmp(arg, "auto noise")) {
-        auto_noise = 1;
+        ctx->options.auto_noise = 1;
       } else if(!strcmp(arg, "auto dual drums")) {
-        auto_dual_drums = 1;
+        ctx->options.auto_dual_drums = 1;
       } else if(!strcmp(arg, "tri sxx to cut")) {
-        tri_sxx_to_cut = 1;
+        ctx->options.tri_sxx_to_cut = 1;
       } else if(!strcmp(arg, "auto decay")) {
-        decay_enabled = 1;
+        ctx->options.decay_enabled = 1;
       } else if(starts_with(arg, "sfx ", &arg2)) {
         // define a sound effect using an instrument
-        soundeffects[sfx_num].instrument = strtol(arg2, &arg2, 16);
+        soundeffect *sfx = &ctx->soundeffects[ctx->sfx_num];
+        sfx->instrument = strtol(arg2, &arg2, 16);
+        need_instrument(ctx, sfx->instrument);
         // skip to channel
         while(*arg2 == ' ')
           arg2++;
@@ -984,260 +4456,150 @@ int main(int argc, char *argv[]) {
           channel = CH_NOISE;
         else if(channel == 't')
           channel = CH_TRIANGLE;
-        soundeffects[sfx_num].channel = channel;
+        sfx->channel = channel;
 
         // skip to name
         while(*arg2 == ' ')
           arg2++;
-        strlcpy(soundeffects[sfx_num].name, arg2, 64);
-        sfx_num++;
+        strlcpy(sfx->name, arg2, 64);
+        ctx->sfx_num++;
       } else if(starts_with(arg, "drumsfx ", &arg2)) {
         // define a drum using sound effects
-        fprintf(output_file, "drum %s\r\n", arg2);
+        char name[80];
+        if(sscanf(arg2, "%79s", name) == 1)
+          intern_symbol(ctx, SYMBOL_DRUM, name, NULL);
+        if(ctx->options.ca65)
+          add_ca65_drum(ctx, arg2);
+        else
+          emit(ctx, "drum %s\r\n", arg2);
+        ctx->costs.drums += 2;
+        ctx->num_drums++;
       } else if(starts_with(arg, "drum ", &arg2)) {
         // drum = assign a drum to a DPCM note
         char *note = strchr(scale, tolower(arg2[0]));
         if(!note)
-          error(1,"invalid note in drum definition (%c)");
+          error(ctx, 1,"invalid note in drum definition (%c)", arg2[0]);
         char *octave_ptr = arg2+1;
-        if(*octave_ptr == '#') 
+        if(*octave_ptr == '#')
           note++;
         if(!isdigit(*octave_ptr))
           octave_ptr++;
         int octave = *octave_ptr-'0';
-        check_range("drum octave", octave, 0, NUM_OCTAVES, NULL);
-        strlcpy(drum_name[octave][note-scale], octave_ptr+2, 16);
+        check_range(ctx, "drum octave", octave, 0, NUM_OCTAVES, NULL);
+        strlcpy(ctx->drum_name[octave][note-scale], octave_ptr+2, 16);
       }
     }
 
-    else if(starts_with(buffer, "COLUMNS ", &arg)) {
+    else if(keyword == KW_COLUMNS) {
       arg = skip_to_number(arg);
       for(i=0;*arg && (i < CHANNEL_COUNT);i++)
-        song.effect_columns[i] = strtol(arg, &arg, 10);
+        song->effect_columns[i] = strtol(arg, &arg, 10);
     }
 
-    else if(starts_with(buffer, "MACRO ", &arg)) {
+    else if(keyword == KW_MACRO) {
       int setting = strtol(arg, &arg, 10);
-      check_range("macro setting type", setting, 0, MACRO_SET_COUNT, NULL);
+      check_range(ctx, "macro setting type", setting, 0, MACRO_SET_COUNT, NULL);
       int id = strtol(arg, &arg, 10);
-      check_range("macro id", id, 0, MAX_INSTRUMENTS, NULL);
-      instrument_macro[setting][id].loop = strtol(arg, &arg, 10);
-      instrument_macro[setting][id].release = strtol(arg, &arg, 10);
-      instrument_macro[setting][id].length = 0;
-      instrument_macro[setting][id].arp_type = strtol(arg, &arg, 10);
+      ftmacro *macro = need_macro(ctx, setting, id);
+      macro->loop = strtol(arg, &arg, 10);
+      macro->release = strtol(arg, &arg, 10);
+      macro->length = 0;
+      macro->arp_type = strtol(arg, &arg, 10);
       arg = skip_to_number(arg);
 
       // read all the numbers and count them
       while(*arg) {
-        instrument_macro[setting][id].sequence[instrument_macro[setting][id].length++] = strtol(arg, &arg, 10);
-        if(instrument_macro[setting][id].length >= MAX_MACRO_LEN)
-          error(1,"instrument \"%s\" has a %s envelope that's too long (max length is %i)", instrument_name[id], envelope_types[setting], MAX_MACRO_LEN);
+        macro->sequence[macro->length++] = strtol(arg, &arg, 10);
+        if(macro->length >= MAX_MACRO_LEN)
+          error(ctx, 1,"%s envelope %i is too long (max length is %i)", envelope_types[setting], id, MAX_MACRO_LEN);
       }
 
       // if auto decay is enabled and this is a volume envelope, try to find a decay envelope
-      if(decay_enabled && setting == MS_VOLUME && instrument_macro[setting][id].loop == -1 &&
-        !instrument_macro[setting][id].sequence[instrument_macro[setting][id].length-1]) {
-
-        int stop = 0;
-        int length_envelope = instrument_macro[setting][id].length-1;     // length in bytes, including the zero so -1
-        for(i=MAX_DECAY_START-1;i>=2 && !stop; i--)                       // try starting volumes in reverse order
-          for(j=0; j<MAX_DECAY_RATE && !stop; j++) {
-            int length_decay = strlen(decay_envelope[i][j]);              // length in bytes, not including zero
-
-            int start_offset = length_envelope - length_decay;            // end of the envelope, backed up to where the decay would start
-            if(!memcmp(instrument_macro[setting][id].sequence + start_offset, decay_envelope[i][j], length_decay)) {
-              instrument_macro[setting][id].decay_index = start_offset;
-              instrument_macro[setting][id].decay_volume = i+1;
-              instrument_macro[setting][id].decay_rate = j+1;
-              stop = 1;                                                   // break out of the loop
-            }
-          }
-      }
-      if(end_of_file)
-        break;
+      if(ctx->options.decay_enabled && setting == MS_VOLUME && macro->loop == -1 &&
+        macro->length && !macro->sequence[macro->length-1])
+        find_decay(macro);
     }
 
-    else if(starts_with(buffer, "INST2A03 ", &arg)) {
+    else if(keyword == KW_INST2A03) {
       int id = strtol(arg, &arg, 10);
-      check_range("instrument id", song.pattern_id, 0, MAX_INSTRUMENTS, NULL);
+      need_instrument(ctx, id);
       for(i=0; i<MACRO_SET_COUNT; i++) {
-        instrument[id][i] = strtol(arg, &arg, 10);
-        check_range("macro sequence id", instrument[id][i], -1, MAX_INSTRUMENTS, NULL);
+        int macro_id = strtol(arg, &arg, 10);
+        check_range(ctx, "macro sequence id", macro_id, -1, MAX_ID, NULL);
+        if(macro_id >= 0)
+          need_macro(ctx, i, macro_id);
+        ctx->instrument[id][i] = macro_id;
       }
       arg = strchr(arg, '\"');
-      sanitize_name(instrument_name[id], arg+1, sizeof(instrument_name[id]));
-
-      // check for duplicate names
-      for(i=0; i<id; i++) {
-         if(!strcmp(instrument_name[i], instrument_name[id])) {
-           char temp[20];
-           duplicate_name_counter++;
-           sprintf(temp, "__%i", duplicate_name_counter);
-           strcat(instrument_name[id], temp);
-           error(0, "Duplicate instrument name (%s), renaming to \"%s\"", instrument_name[i], instrument_name[id]);
-           break;
-         }
+      char *name = ctx->instrument_name[id];
+      sanitize_name(name, arg+1, sizeof(ctx->instrument_name[id]));
+
+      // short names are numbered, so only the module's own names can be duplicates
+      if(ctx->options.short_names) {
+        char short_name[16];
+        snprintf(short_name, sizeof(short_name), "i%i", id);
+        intern_symbol(ctx, SYMBOL_INSTRUMENT, short_name, name);
+        strlcpy(name, short_name, sizeof(ctx->instrument_name[id]));
+      } else if(intern_symbol(ctx, SYMBOL_INSTRUMENT, name, NULL)) {
+        char renamed[sizeof(ctx->instrument_name[id])+16];
+        snprintf(renamed, sizeof(renamed), "%s__%i", name, ++ctx->duplicate_name_counter);
+        error(ctx, 0, "Duplicate instrument name (%s), renaming to \"%s\"", name, renamed);
+        strlcpy(name, renamed, sizeof(ctx->instrument_name[id]));
+        intern_symbol(ctx, SYMBOL_INSTRUMENT, name, NULL);
       }
     }
 
-    else if(starts_with(buffer, "ORDER ", &arg)) {
+    else if(keyword == KW_ORDER) {
       int id = strtol(arg, &arg, 16);
-      song.frames = id+1; // assume last frame in file is last frame in song
-      check_range("frame number", id, 0, MAX_FRAMES, song.real_name);
+      check_range(ctx, "frame number", id, 0, MAX_ID, song->real_name);
+      song->frame = grow_array(ctx, song->frame, &song->frames_allocated, id+1, sizeof(*song->frame));
+      song->frames = id+1; // assume last frame in file is last frame in song
       arg = skip_to_number(arg);
       for(i=0; i<CHANNEL_COUNT; i++)
-        song.frame[id][i] = strtol(arg, &arg, 16);
+        song->frame[id][i] = strtol(arg, &arg, 16);
+    }
+
+    if(ctx->song_cache.load && !end_of_file) {
+      if(keyword == KW_TRACK || keyword == KW_COLUMNS || keyword == KW_ORDER || keyword == KW_PATTERN || keyword == KW_ROW)
+        song->hash = ft2p_hash(song->hash, &line_hash, sizeof(line_hash));
+      else
+        ctx->global_hash = ft2p_hash(ctx->global_hash, &line_hash, sizeof(line_hash));
     }
 
     // export things if needed
     if(end_of_file) {
-      // write automatic noise+triangle drums if needed
-      if(auto_dual_drums) {
-        for(int j=0; j<MAX_INSTRUMENTS; j++) {
-          // create noise sound effects
-          // for instruments that appear in auto_drum_noise
-          for(int i=0; i<num_auto_drums; i++) {
-            if(auto_drum_noise[i] != j)
-              continue;
-            soundeffects[sfx_num].instrument = j;
-            soundeffects[sfx_num].channel = CH_NOISE;
-            sprintf(soundeffects[sfx_num].name, "autonoise%x_", j);
-            sfx_num++;
-            break;
-          }
-
-          // create triangle sound effects
-          // for instruments that appear in auto_drum_tri
-          for(int i=0; i<num_auto_drums; i++) {
-            if(auto_drum_tri[i] != j)
-              continue;
-            soundeffects[sfx_num].instrument = j;
-            soundeffects[sfx_num].channel = CH_TRIANGLE;
-            sprintf(soundeffects[sfx_num].name, "autotriangle%x_", j);
-            sfx_num++;
-            break;
-          }
-
-        }
-
-        // create drums using both these sound effects
-        for(int i=0; i<num_auto_drums; i++) {
-          printf("%i noise %x, triangle %x\n", i, auto_drum_noise[i], auto_drum_tri[i]);
-          if(auto_drum_tri[i] == 255)
-            fprintf(output_file, "\r\ndrum autodrum%i_ autonoise%x_", i, auto_drum_noise[i]);
-          else
-            fprintf(output_file, "\r\ndrum autodrum%i_ autonoise%x_ autotriangle%x_", i, auto_drum_noise[i], auto_drum_tri[i]);
-        }
-      }
-
-      xsong = song;
+      xsong = ctx->xsong = song;
+      enter_phase(ctx, PHASE_MACROS);
       // write sound effects
-      for(i=0; i<sfx_num; i++) {
-        int instrument = soundeffects[i].instrument, channel = soundeffects[i].channel;
-        // sound effects don't like being put on "pulse1" so replace it with "pulse"
-        const char *channel_name = chan_name[channel];
-        if(channel == CH_SQUARE1)
-          channel_name = "pulse";
-        fprintf(output_file, "\r\nsfx %s on %s\r\n", soundeffects[i].name, channel_name);
-
-        // use absolute pitch for non-noise; decay disallowed
-        write_instrument(output_file, instrument, (channel != CH_NOISE)?ABSOLUTE_PITCH:0);
-      }
+      for(i=0; i<ctx->sfx_num; i++)
+        write_sfx(ctx, ctx->soundeffects[i].instrument, ctx->soundeffects[i].channel, ctx->soundeffects[i].name, NULL);
       // write instruments
-      for(i=0; i<MAX_INSTRUMENTS; i++)
-        if(instrument_used[i]) {
-          fprintf(output_file, "\r\ninstrument %s\r\n", instrument_name[i]);
-          write_instrument(output_file, i, ALLOW_DECAY);
+      for(i=0; i<ctx->num_instruments; i++)
+        if(ctx->instrument_used[i] && ctx->options.ca65) {
+          ctx->costs.instruments += 5 + 2*write_ca65_instrument(ctx, i, ALLOW_DECAY, ctx->instrument_name[i], -1);
+        } else if(ctx->instrument_used[i]) {
+          emit(ctx, "\r\ninstrument %s\r\n", ctx->instrument_name[i]);
+          ctx->costs.instruments += 5 + 2*write_instrument(ctx, i, ALLOW_DECAY);
         }
       need_song_export = 1;
     }
     if(need_song_export) {
-      fprintf(output_file, "\r\nsong %s\r\n  time 4/4\r\n  scale 16\r\n  title %s\r\n", xsong.name, xsong.real_name);
-      write_tempo(output_file, xsong.speed, xsong.tempo);
-      fprintf(output_file, "\r\n");
-
-      // write the actually used (not empty) patterns
-      for(j=0; j<CHANNEL_COUNT; j++)
-        for(i=0; i<MAX_PATTERNS; i++) {
-          int not_empty = 0;
-          for(int row = 0; row < xsong.rows; row++)
-            if(isalnum(xsong.pattern[i][j][row].note)) {
-              not_empty = 1;
-              break;
-            }
-          xsong.pattern_used[i][j] = not_empty;
-
-          if(not_empty)
-            write_pattern(output_file, i, j);
-        }
-
-      // write the frames
-      int channel_playing[CHANNEL_COUNT] = {1, 1, 1, auto_noise||auto_dual_drums, !(auto_noise||auto_dual_drums), 0};
-      int total_rows = 0;
-      for(i=0; i<xsong.frames; i++) {
-        fprintf(output_file, "\r\n  at ");
-        write_time(output_file, total_rows);
-        if(xsong.loop_to == i && xsong.loop_to)
-          fprintf(output_file, "\r\n  segno");
-
-        int min_length = MAX_ROWS; // minimum pattern length in this frame
-        for(j=0; j<CHANNEL_COUNT; j++) {
-          int pattern = xsong.frame[i][j];
-          if(( (!(auto_noise||auto_dual_drums) && j != CH_NOISE)
-             || ((auto_noise||auto_dual_drums) && j != CH_DPCM))
-            && xsong.pattern_used[pattern][j]) {
-            fprintf(output_file, "\r\n  play pat_%i_%i_%i", song_num, j, pattern);
-            channel_playing[j] = 1;
-          } else if(channel_playing[j]) { // stop channel if it was playing but now it isn't
-            if(j == CH_NOISE || j == CH_DPCM)
-              fprintf(output_file, "\r\n  stop drum");
-            else
-              fprintf(output_file, "\r\n  stop %s", chan_name[j]);
-            channel_playing[j] = 0;
-          }
-          if(xsong.pattern_length[pattern][j] < min_length)
-            min_length = xsong.pattern_length[pattern][j];
-        }
-
-        // look for tempo changes
-        for(int row=0; row<min_length; row++) {
-          int speed = 0, tempo = 0, attack=-1;
-          for(int j=0; j<CHANNEL_COUNT; j++) {
-            int pattern = xsong.frame[i][j];
-            ftnote *note = &xsong.pattern[pattern][j][row];
-            for(int fx=0; fx<MAX_EFFECTS; fx++)
-              if(note->effect[fx] == FX_TEMPO) {
-                if(note->param[fx] < 0x20)
-                  speed = note->param[fx];
-                else
-                  tempo = note->param[fx];
-              } else if(note->effect[fx] == FX_ATTACK_ON && j == CH_ATTACK)
-                attack = note->param[fx];
-          }
-          if(speed||tempo||(attack>=0)) {
-            if(row) {
-              fprintf(output_file, "\r\n  at ");
-              write_time(output_file, total_rows+row);
-            }
-            if(speed||tempo) {
-              fprintf(output_file, "\r\n");
-              write_tempo(output_file, speed?speed:xsong.speed, tempo?tempo:xsong.tempo);
-            }
-            if(attack>=0) {
-              fprintf(output_file, "\r\n  attack on %s", chan_name[attack]);
-            }
-          }
-        }
-        total_rows += min_length;
+      // at a TRACK line song_num has already moved on to the new song
+      int xsong_num = end_of_file ? ctx->song_num : ctx->song_num-1;
+      xsong->global_hash = ctx->global_hash;
+      index_song_events(ctx, xsong);
+      build_song_timeline(ctx, xsong);
+      if((ctx->options.pipeline || ctx->options.song_threads > 1) && !end_of_file) {
+        // let an exporter thread write it while the next song is parsed
+        pipeline_push(ctx, xsong, xsong_num);
+      } else {
+        enter_phase(ctx, PHASE_SONG); // timed by write_song itself
+        write_song(ctx, xsong, xsong_num);
+        // the song has been written, so its patterns aren't needed anymore
+        if(xsong != song)
+          free_song(xsong);
       }
-      fprintf(output_file, "\r\n  at ");
-      write_time(output_file, total_rows);
-      fprintf(output_file, "\r\n  ");
-      if(xsong.loop_to != -1)
-        fprintf(output_file, "dal segno");
-      else
-        fprintf(output_file, "fine");
-
+      xsong = ctx->xsong = NULL;
       need_song_export = 0;
     }
 
@@ -1245,50 +4607,34 @@ int main(int argc, char *argv[]) {
       break;
   }
 
-  // write automatic noise instruments if needed
-  if(auto_noise)
-    for(i=0; i<MAX_INSTRUMENTS; i++)
-      if(instrument_noise[i])
-        for(j=0; j<16; j++)
-          if(instrument_noise[i] & (1 << j)) {
-            // make a new sound effect for the noise frequency
-            fprintf(output_file, "\r\nsfx noise_%s_%x on noise\r\n", instrument_name[i], j);
-
-            // get the arpeggio envelope, change it and restore it to what it was
-            unsigned int num_macro_arp    = (unsigned)instrument[i][MS_ARPEGGIO];
-            unsigned int num_macro_duty   = (unsigned)instrument[i][MS_DUTY];
-            if(num_macro_arp >= MAX_INSTRUMENTS) {
-              // no arpeggio set, so make one
-              ftmacro new_macro = {1, -1, -1, 0, {0}, 0, 0, 0};
-              instrument_macro[MS_ARPEGGIO][MAX_INSTRUMENTS-1] = new_macro;
-              instrument[i][MS_ARPEGGIO] = MAX_INSTRUMENTS-1;
-              num_macro_arp = MAX_INSTRUMENTS - 1;
-            }
-            int k;
-            if(num_macro_duty < MAX_INSTRUMENTS) {
-              // if duty is used, wrap all duty values to 0 and 1
-              // we don't need to worry about saving and restoring because the macros
-              // won't be needed after the automatic noise drums are written
-              ftmacro *duty_macro = &instrument_macro[MS_DUTY][num_macro_duty];
-              for(k=0; k<duty_macro->length; k++)
-                duty_macro->sequence[k] &= 1;
-            }
+  // write automatic drums if needed
+  enter_phase(ctx, PHASE_AUTO_NOISE);
+  if(ctx->options.auto_dual_drums)
+    write_auto_dual_drums(ctx);
+  if(ctx->options.auto_noise)
+    write_auto_noise_drums(ctx);
 
-            ftmacro *arp_macro = &instrument_macro[MS_ARPEGGIO][num_macro_arp];
-            ftmacro old = *arp_macro;
-            for(k=0; k<arp_macro->length; k++)
-              arp_macro->sequence[k] = (arp_macro->sequence[k]+j)&15;
-            write_instrument(output_file, i, 0); // disallow decay
-            *arp_macro = old;
-
-            // define a drum for the frequency
-            fprintf(output_file, "\r\ndrum %s_%x_ noise_%s_%x", instrument_name[i], j, instrument_name[i], j);
-          }
+  intern_pattern_names(ctx);
+  if(ctx->options.ca65)
+    write_ca65_tables(ctx);
+  emit_text(ctx, "\r\n\r\n");
 
-  // close files
-  fclose(input_file);
-  fprintf(output_file, "\r\n\r\n");
-  fclose(output_file);
+  ft2p_costs *costs = &ctx->costs;
+  costs->total = costs->instruments + costs->sfx + costs->drums;
+  for(i=0; i<costs->num_songs; i++)
+    costs->total += costs->song[i].patterns + costs->song[i].conductor;
+  if(ctx->options.budget && costs->total > ctx->options.budget)
+    error(ctx, 1, "estimated size (%i bytes) is over the budget of %i bytes", costs->total, ctx->options.budget);
 
+  if(ctx->options.merge_instruments)
+    log_printf(ctx, "%i instruments merged\n", ctx->instruments_merged);
+  if(ctx->options.factor_patterns)
+    log_printf(ctx, "%i runs of rows split off and played %i more times, saving about %i bytes\n",
+               ctx->pieces_factored, ctx->pieces_shared, ctx->factor_bytes_saved);
+  if(ctx->options.dedup_patterns || ctx->options.transpose_patterns)
+    log_printf(ctx, "%i patterns shared (%i transposed), saving %lu bytes\n", ctx->patterns_shared, ctx->patterns_transposed, (unsigned long)ctx->pattern_bytes_saved);
+  finish_stats(ctx);
+  flush_output(ctx);
+  write_symbol_map(ctx);
   return 0;
 }
@@ -0,0 +1,451 @@
+/*
+ * ft2pently
+ *
+ * Copyright (C) 2016-2018 NovaSquirrel
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FT2P_H
+#define FT2P_H
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+// maximum values, used for array sizes
+#define MAX_EFFECTS     4
+#define MAX_ROWS        256
+#define MAX_ID          32768 // sanity limit on pattern, frame, instrument and macro numbers, to catch garbage
+#define MAX_MACRO_LEN   255  // real max is like 254?
+#define NUM_OCTAVES     7
+#define NUM_SEMITONES   12
+#define MAX_SFX         64
+#define MAX_DECAY_START 15   // starting volume
+#define MAX_DECAY_RATE  16   // decay rate
+#define MAX_DECAY_LEN   256  // actually goes up to 224 or something but this is to be safe
+#define MAX_SONGS       64
+#define SONG_NAME_LEN   32
+#define MAX_DRUMS       25
+#define MAX_AUTO_DRUMS  256  // auto dual drums seen, before the ones that don't fit are merged
+
+//////////////////// enums and structs ////////////////////
+// sound channels
+enum {
+  CH_SQUARE1,
+  CH_SQUARE2,
+  CH_TRIANGLE,
+  CH_NOISE,
+  CH_DPCM,      // not supported, but used for Pently drums
+  CH_ATTACK,    // MMC5's first expansion square channel
+  CHANNEL_COUNT
+};
+
+// types of envelopes
+enum {
+  MS_VOLUME,
+  MS_ARPEGGIO,
+  MS_PITCH,
+  MS_HIPITCH,
+  MS_DUTY,
+  MACRO_SET_COUNT
+};
+
+// arpeggio types, numbered the way Famitracker saves them
+enum {
+  ARP_ABSOLUTE,
+  ARP_FIXED,
+  ARP_RELATIVE
+};
+
+// supported note effects
+enum {
+  FX_NONE     = 0,
+  FX_ARP      = '0', // arpeggio
+  FX_SLUR     = '3', // enable slur if nonzero
+  FX_VIBRATO  = '4', // vibrato change
+  FX_LOOP     = 'B', // jump to frame X
+  FX_FINE     = 'C', // stop song
+  FX_PAT_CUT  = 'D', // skip to next pattern
+  FX_TEMPO    = 'F', // change tempo or speed
+  FX_DELAY    = 'G', // delay for X frames
+  FX_SLUR_UP  = 'Q', // note for one row, slur into pitch X semitones up
+  FX_SLUR_DN  = 'R', // note for one row, slur into pitch X semitones down
+  FX_DELAYCUT = 'S', // grace note for X frames then rest
+  FX_ATTACK_ON= 'J'  // repurposed to specify attack target
+};
+
+// volumes
+enum {
+  VOL_SAME, // no change
+  VOL_FF,   // 100%
+  VOL_MF,   // 75%
+  VOL_MP,   // 50%
+  VOL_PP,   // 25%
+};
+
+// a sound effect definition, held onto until end of export
+// used for drums and auto-generated noise drums
+typedef struct soundeffect {
+  int instrument;
+  uint8_t channel;
+  uint8_t pitch; // pitch offset for auto noise, or 0
+  char name[64];
+} soundeffect;
+
+// a note on a pattern
+typedef struct ftnote {
+  uint8_t octave;             // octave number
+  char note;                  // note name, capitalized if sharp
+  int16_t instrument;         // instrument number
+  uint8_t volume;             // note volume, uses VOL_* values
+  char effect[MAX_EFFECTS];   // effect letter
+  uint8_t param[MAX_EFFECTS]; // effect parameter
+  uint8_t slur;               // nonzero if note has slur
+} ftnote;
+
+// the name a pattern was written under, which is pat_<song_num>_<channel>_<id>, or pat_<song_num>_<channel>_<id>_<row>
+// for a piece of a pattern that factor_patterns split up
+typedef struct ftlabel {
+  int song_num, channel, id;
+  int row;       // first row of the piece, or 0 for a whole pattern
+  int transpose; // semitones to play it up or down by
+} ftlabel;
+
+// a run of rows that factor_patterns split a pattern into, which the conductor starts playing partway through the frame
+typedef struct ftpiece {
+  int row;        // first row
+  int instrument; // instrument it starts with
+  int from_id, from_channel, from_row; // identical piece that this one plays instead of being written, or from_id = -1
+  ftlabel label;
+} ftpiece;
+
+// a row of a pattern that has anything on it; the export goes from event to event instead of row to row,
+// so empty rows cost nothing
+typedef struct ftevent {
+  uint16_t row;
+  uint8_t flags; // EVENT_* bits
+} ftevent;
+
+enum {
+  EVENT_NOTE    = 1,  // anything in the note column, including note cuts
+  EVENT_PLAYED  = 2,  // a note that sounds, which makes the pattern worth writing
+  EVENT_VOLUME  = 4,
+  EVENT_EFFECT  = 8,
+  EVENT_CONTROL = 16, // a tempo or attack effect, which the conductor has to handle
+};
+
+// one pattern for every channel, only allocated for patterns that actually appear in the file
+typedef struct ftpattern {
+  ftnote *row[CHANNEL_COUNT];        // the song's number of rows, plus one extra for slurs off the end
+  ftevent *event[CHANNEL_COUNT];     // the rows that have anything on them, in order, listed once the song is read
+  int events[CHANNEL_COUNT];
+  ftevent *control[CHANNEL_COUNT];   // just the ones with tempo or attack effects, for the song's timeline
+  int controls[CHANNEL_COUNT];
+  uint32_t filled[CHANNEL_COUNT][MAX_ROWS/32+1]; // a bit for each row the parser wrote to, so listing events skips the rest
+  int length[CHANNEL_COUNT];         // rows before any loop, cut or fine
+  uint8_t used[CHANNEL_COUNT];       // nonzero if the channel has any notes
+  ftlabel label[CHANNEL_COUNT];      // what "play" calls it; an identical pattern's name if it was shared
+  ftpiece *piece[CHANNEL_COUNT];     // with factor_patterns, the pieces each channel was split into
+  int pieces[CHANNEL_COUNT];         // or 0 if it wasn't split
+} ftpattern;
+
+// a pattern that was already written, remembered so that identical ones can be shared
+typedef struct ftwritten_pattern {
+  uint64_t hash;
+  char *text;    // the channel group, then the pattern without its name or channel (or its relative pitches)
+  size_t length;
+  ftlabel label;
+  int base;      // semitone of the first note, for patterns compared with transposition
+} ftwritten_pattern;
+
+// where an automatic drum is played in the output, so it can be renamed if it's merged into another one
+typedef struct ftdrumref {
+  size_t offset;
+  int length;
+} ftdrumref;
+
+// what the rows before the current one on a channel leave behind, carried forward as rows are read
+// instead of looking back through the pattern for every row
+typedef struct ftchannel_state {
+  int next_row;        // first row that hasn't been taken into account yet
+  int last_volume;     // last volume change, or VOL_SAME
+  int last_instrument; // instrument of the last note that had one, or -1
+  int last_note;       // row of the last note or note cut, or -1
+} ftchannel_state;
+
+// something the conductor does at a row partway through a song, other than starting and stopping patterns;
+// each row only has one, with the effects of all of the channels combined
+typedef struct ftcontrol {
+  int row;              // counted from the start of the song
+  uint8_t speed, tempo; // 0 if unchanged
+  int8_t attack;        // channel that attack moves to, or -1
+  uint8_t segno;        // the song loops back to here
+} ftcontrol;
+
+// a song and its patterns
+typedef struct ftsong {
+  // Explicitly stated song information
+  char real_name[SONG_NAME_LEN]; // name to display for errors
+  char name[SONG_NAME_LEN];      // sanitized name for the actual file
+  int rows, speed, tempo;
+
+  // Buffers to hold song information, which grow as needed
+  int (*frame)[CHANNEL_COUNT];
+  ftpattern **pattern;               // indexed by pattern number, NULL for patterns that never appear
+  int frames_allocated, patterns_allocated;
+  int effect_columns[CHANNEL_COUNT]; // number of effect columns
+  int loop_to;                       // frame to insert the segno at, or -1 for no looping
+
+  // the song's timeline, made once it's been read: where each frame starts (frames end at the first loop, cut or fine
+  // on any channel), with one more for where the song ends, and what the conductor does along the way, in order
+  int *frame_start;
+  ftcontrol *control;
+  int controls, controls_allocated;
+
+  // Song status information for parsing purposes
+  int pattern_id, frames;
+  uint64_t hash, global_hash; // of the song's lines and of the other lines before it was done, for the song cache
+  ftchannel_state channel_state[CHANNEL_COUNT]; // for the pattern being read
+} ftsong;
+
+// an instument envelope
+typedef struct ftmacro {
+  uint8_t length;         // up to MAX_MACRO_LEN, so the long decays fit
+  int16_t loop, release;
+  int8_t arp_type; // ARP_*; only the renderer uses it
+  int8_t sequence[MAX_MACRO_LEN];
+  uint8_t decay_rate;   // if 0, decay isn't used
+  uint8_t decay_volume; // starting volume to use for decay
+  uint8_t decay_index;  // index decay starts
+} ftmacro;
+
+// kinds of names the output defines; each kind has names of its own
+enum {
+  SYMBOL_SONG,
+  SYMBOL_INSTRUMENT,
+  SYMBOL_SFX,
+  SYMBOL_DRUM,
+  SYMBOL_PATTERN
+};
+
+// a name the output defines
+typedef struct ftsymbol {
+  uint64_t hash;
+  char name[80];
+  char long_name[80]; // with short_names, the name it stands for (for instruments, the module's), or "" if it's the same
+  uint8_t kind;       // SYMBOL_*
+} ftsymbol;
+
+// export options; all zero gives the default behavior
+typedef struct ft2p_options {
+  int decay_enabled;    // use the decay feature
+  int auto_noise;       // automatically convert noise instruments to drums
+  int auto_dual_drums;  // automatically convert fixed arpeggio noise instruments to drums (with triangle part)
+  int hex_rows;         // display row numbers in hex instead of decimal
+  int strict;           // turn warnings into errors
+  int tri_sxx_to_cut;   // convert delayed triangle note cuts to regular note cuts
+  int dotted_durations; // use dotted durations in the output file
+  int pipeline;         // write each song on another thread while the next one is parsed
+  int song_threads;     // if more than 1, write up to this many songs at once, each on its own thread (implies pipeline)
+  int dedup_patterns;   // write identical patterns only once, even across songs and channels
+  int transpose_patterns; // also share patterns that only differ by being transposed (implies dedup_patterns)
+  int merge_instruments; // write instruments with identical envelopes only once, and use the first one's name for all of them
+  int factor_patterns;  // split runs of rows that repeat within a song into patterns of their own, played partway through frames
+  int stats;            // time each phase of the conversion (counts are kept either way)
+  int budget;           // if nonzero, fail if the estimated size in bytes is bigger than this
+  int ca65;             // write Pently's data as ca65 source instead of pentlyas MML
+  int render_rate;      // if nonzero, also play each song at this many samples per second and send it to ctx->render
+  int short_names;      // name instruments, patterns and automatic drums and sound effects with short generated names, listed in ctx->map
+} ft2p_options;
+
+// somewhere to send text to; used both for the converted file and for warnings
+typedef struct ft2p_sink {
+  void (*write)(void *user, const char *data, size_t length);
+  void *user;
+} ft2p_sink;
+
+// somewhere to send each song to once it's been played, as a WAV file
+typedef struct ft2p_render_sink {
+  void (*write)(void *user, int song_num, const char *name, const char *wav, size_t length);
+  void *user;
+} ft2p_render_sink;
+
+// growable block of memory that the converted file is built up in
+typedef struct ft2p_buffer {
+  char *data;
+  size_t length, capacity;
+} ft2p_buffer;
+
+// the tables that ca65 output collects while converting and writes at the end
+enum {
+  CA65_INSTRUMENTS,
+  CA65_SFX,
+  CA65_DRUMS,
+  CA65_TABLE_COUNT
+};
+
+// estimated ROM bytes, following how pentlyas encodes what ft2pently writes
+typedef struct ft2p_song_cost {
+  char name[SONG_NAME_LEN];
+  int patterns;  // patterns written in this song, not counting ones shared from earlier songs
+  int conductor; // the song's frame list and its entry in the song table
+} ft2p_song_cost;
+
+typedef struct ft2p_pattern_cost {
+  ftlabel label;
+  int bytes;
+} ft2p_pattern_cost;
+
+typedef struct ft2p_costs {
+  int instruments, sfx, drums, total;
+  int num_songs;
+  ft2p_song_cost song[MAX_SONGS];
+  int num_patterns, patterns_allocated;
+  ft2p_pattern_cost *pattern;
+} ft2p_costs;
+
+// parts of a conversion that are timed for ft2p_write_stats
+enum {
+  PHASE_PARSE,
+  PHASE_MACROS,     // reading envelopes and finding decays, merging and writing instruments
+  PHASE_PATTERNS,
+  PHASE_CONDUCTOR,  // each song's frame list
+  PHASE_AUTO_NOISE, // sound effects made for auto noise
+  PHASE_INCLUDE,    // copying included files
+  PHASE_RENDER,     // playing songs for render_rate
+  PHASE_SONG,       // writing a song on the parser's thread, which write_song splits into patterns and conductor
+  PHASE_COUNT
+};
+
+// what a conversion did and how long it took
+typedef struct ft2p_stats {
+  double seconds[PHASE_COUNT];
+  double total;
+  long lines, rows, notes;
+  int patterns_written, patterns_empty, songs_cached, auto_drums;
+  size_t bytes_written;
+  long peak_memory_kb;    // of the whole process, or 0 if it isn't known
+  int phase;              // what the parser's thread is doing, and since when
+  double mark;
+} ft2p_stats;
+
+// somewhere to keep songs that were already written, so that unchanged songs don't need to be written again;
+// "load" returns a malloc'd copy of what was saved under a key (and its length), or NULL if there isn't anything
+typedef struct ft2p_song_cache {
+  void *(*load)(void *user, uint64_t key, size_t *length);
+  void (*save)(void *user, uint64_t key, const void *data, size_t length);
+  void *user;
+} ft2p_song_cache;
+
+// all of the state for one converter; reusable for any number of conversions,
+// but only one conversion at a time may use a given context
+typedef struct ft2p_pipeline ft2p_pipeline; // private to ft2p.c
+
+typedef struct ft2p_context {
+  ftsong *song;  // song being parsed
+  ftsong *xsong; // song being exported
+  ft2p_pipeline *pipeline; // exporter threads, while they are running
+
+  // module parsing state; the per-instrument and per-macro tables grow as higher numbers are seen
+  int song_num, sfx_num;
+  int num_instruments, instruments_allocated;
+  int16_t (*instrument)[MACRO_SET_COUNT];
+  uint8_t *instrument_used;
+  uint8_t *instrument_ignore;
+  char (*instrument_name)[32];
+  uint16_t *instrument_noise; // each bit in each 16-bit value corresponds to a needed frequency
+  int16_t *instrument_alias;  // instrument that notes with each instrument use instead, for merge_instruments
+  int instruments_merged;
+  int num_macros[MACRO_SET_COUNT], macros_allocated[MACRO_SET_COUNT];
+  ftmacro *instrument_macro[MACRO_SET_COUNT];
+  int num_auto_drums;
+  int auto_drum_noise[MAX_AUTO_DRUMS];
+  uint8_t auto_drum_tri[MAX_AUTO_DRUMS];
+  int num_drums;              // drums defined so far, of every kind
+  int num_drum_refs, drum_refs_allocated;
+  ftdrumref *drum_refs;       // where automatic drums are played in "out", in order
+  char drum_name[NUM_OCTAVES][NUM_SEMITONES][16];
+  soundeffect soundeffects[MAX_SFX];
+  int duplicate_name_counter;
+
+  // names of songs, instruments, sound effects and drums defined so far, in order, for finding duplicates and for
+  // ctx->map; the index is a hash table of symbols indexes, -1 if empty
+  int num_symbols, symbols_allocated, symbol_slots;
+  ftsymbol *symbols;
+  int *symbol_index;
+
+  // patterns written so far, for dedup_patterns; the index is a hash table of written_patterns indexes, -1 if empty
+  int num_written_patterns, written_patterns_allocated, written_pattern_slots;
+  ftwritten_pattern *written_patterns;
+  int *written_pattern_index;
+  int patterns_shared, patterns_transposed;
+  size_t pattern_bytes_saved;
+  int pieces_factored, pieces_shared, factor_bytes_saved; // for factor_patterns; bytes saved are estimated
+  ft2p_costs costs;       // estimated size of what was written
+  ft2p_buffer ca65_table[CA65_TABLE_COUNT]; // table entries for ca65 output
+  ft2p_stats stats;
+
+  // export options, copied from the caller and then changed by song comments
+  ft2p_options options;
+
+  // where the output and any warnings go
+  ft2p_buffer out;        // the converted file so far; sent to "output" in one write when the conversion ends
+  ft2p_sink output, log;
+  ft2p_render_sink render; // only used with render_rate
+  ft2p_sink map;          // with short_names, gets a line for each short name with the name it stands for
+  ft2p_song_cache song_cache; // left unset to not cache songs; not used while patterns are shared between songs
+  uint64_t global_hash;   // of the lines outside of songs, for the song cache
+  char *last_line;        // copy of the last line of the input, if it had no line ending
+  char location[200];     // buffer for error_location()
+  char error_text[300];   // the error that stopped the last conversion, if any
+  jmp_buf error_jump;     // where error() goes back to when it stops the conversion
+} ft2p_context;
+
+//////////////////// library interface ////////////////////
+
+// allocates a converter; returns NULL if out of memory
+// (song and instrument storage is allocated during conversion, as big as each file needs)
+ft2p_context *ft2p_new(void);
+void ft2p_free(ft2p_context *ctx);
+
+// converts a Famitracker text export held in memory, sending the result to "output" in one write
+// (or if "output" is NULL, leaving it in ctx->out until the next conversion);
+// the export is parsed in place, so its line endings are overwritten with zeros
+// warnings and errors go to ctx->log (stdout if it's left unset)
+// returns 0 on success, or -1 if there was an error, which is described in ctx->error_text
+int ft2p_convert(ft2p_context *ctx, char *input, size_t length, const ft2p_sink *output, const ft2p_options *options);
+
+// checks whether a file is a binary Famitracker module (.ftm or .0cc) rather than a text export
+int ft2p_is_module(const char *data, size_t length);
+
+// reads a binary module into the text export Famitracker would have written for it, ready for ft2p_convert();
+// returns the text, which the caller frees, or NULL if there was an error, which is described in ctx->error_text
+char *ft2p_read_module(ft2p_context *ctx, const char *data, size_t length, size_t *text_length);
+
+// writes a report of the estimated ROM size of the last conversion, as text or JSON,
+// listing the "top" biggest patterns
+void ft2p_write_costs(ft2p_context *ctx, const ft2p_sink *sink, int json, int top);
+
+// writes the counts and (if options.stats was set) the time taken by each phase of the last conversion
+void ft2p_write_stats(ft2p_context *ctx, const ft2p_sink *sink, int json);
+
+// the name a phase is reported under (as in "auto_noise"), or NULL for PHASE_SONG and anything past it,
+// which aren't reported on their own
+const char *ft2p_phase_name(int phase);
+
+// adds some bytes to a 64-bit FNV-1a hash, which starts out as FT2P_HASH_START; the song cache's keys are made with it,
+// so a front end that keys whole conversions can use the same hash
+#define FT2P_HASH_START 14695981039346656037ULL
+uint64_t ft2p_hash(uint64_t hash, const void *data, size_t length);
+
+#endif
@@ -0,0 +1,828 @@
+/*
+ * ft2pently
+ *
+ * Copyright (C) 2016-2018 NovaSquirrel
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+// command line front end for the converter in ft2p.c
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#ifdef __linux__
+#include <poll.h>
+#include <time.h>
+#include <sys/inotify.h>
+#endif
+#include "ft2p.h"
+
+// reads a whole file into memory; returns NULL if it can't be read
+static char *read_file(const char *filename, size_t *length) {
+  FILE *file = fopen(filename, "rb");
+  if(!file)
+    return NULL;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  rewind(file);
+  char *data = malloc(size+1);
+  if(data && size >= 0 && fread(data, 1, size, file) == (size_t)size) {
+    data[size] = 0;
+    *length = size;
+  } else {
+    free(data);
+    data = NULL;
+  }
+  fclose(file);
+  return data;
+}
+
+// an input file loaded into memory, either mapped or read in
+typedef struct input_file {
+  char *data;
+  size_t length;
+  int mapped;
+} input_file;
+
+// maps an input file into memory as a private copy-on-write mapping, so the converter can parse it
+// in place without reading it into a buffer first; falls back to reading it if it can't be mapped
+static int load_input(input_file *file, const char *filename) {
+  file->mapped = 0;
+#ifndef _WIN32
+  int fd = open(filename, O_RDONLY);
+  if(fd < 0)
+    return -1;
+  struct stat info;
+  if(!fstat(fd, &info) && info.st_size > 0) {
+    void *data = mmap(NULL, info.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if(data != MAP_FAILED) {
+      close(fd);
+      file->data = data;
+      file->length = info.st_size;
+      file->mapped = 1;
+      return 0;
+    }
+  }
+  close(fd);
+#endif
+  file->data = read_file(filename, &file->length);
+  return file->data ? 0 : -1;
+}
+
+static void unload_input(input_file *file) {
+#ifndef _WIN32
+  if(file->mapped) {
+    munmap(file->data, file->length);
+    return;
+  }
+#endif
+  free(file->data);
+}
+
+// sink that writes straight to a file
+static void write_file(void *user, const char *data, size_t length) {
+  fwrite(data, 1, length, (FILE*)user);
+}
+
+// render sink that saves each song next to the output file it's from, as <output>.<song>.wav
+static void write_render_file(void *user, int song_num, const char *name, const char *wav, size_t length) {
+  char filename[1100];
+  (void)song_num;
+  snprintf(filename, sizeof(filename), "%s.%s.wav", (const char*)user, name);
+  FILE *file = fopen(filename, "wb");
+  if(!file)
+    return;
+  fwrite(wav, 1, length, file);
+  fclose(file);
+}
+
+// with -shortnames, starts a map of the short names next to the output file, as <output>.map;
+// returns the file to close once the conversion is done, or NULL
+static FILE *open_map(ft2p_context *ctx, const char *out_filename, const ft2p_options *options) {
+  ctx->map.write = NULL;
+  if(!options->short_names)
+    return NULL;
+  char filename[1100];
+  snprintf(filename, sizeof(filename), "%s.map", out_filename);
+  FILE *file = fopen(filename, "wb");
+  if(file) {
+    ctx->map.write = write_file;
+    ctx->map.user = file;
+  }
+  return file;
+}
+
+// report settings
+static int show_costs, show_stats, report_json, costs_top = 10;
+
+//////////////////// conversion cache ////////////////////
+
+// growable block of text, used to hold on to warnings until it's time to print or save them
+typedef struct textbuf {
+  char *data;
+  size_t length, capacity;
+} textbuf;
+
+// sink that appends to a textbuf
+static void write_textbuf(void *user, const char *data, size_t length) {
+  textbuf *buf = user;
+  if(buf->length + length > buf->capacity) {
+    size_t capacity = buf->capacity ? buf->capacity : 256;
+    while(capacity < buf->length + length)
+      capacity *= 2;
+    char *grown = realloc(buf->data, capacity);
+    if(!grown)
+      return;
+    buf->data = grown;
+    buf->capacity = capacity;
+  }
+  memcpy(buf->data + buf->length, data, length);
+  buf->length += length;
+}
+
+// appends a zero terminated string to a textbuf
+static void append_text(textbuf *buf, const char *text) {
+  write_textbuf(buf, text, strlen(text));
+}
+
+static const char *cache_directory; // set by -cache
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static int cache_files_written;
+
+// calls "found" with the name of each file that an input includes, before the converter has seen the input
+static void find_includes(const char *input, size_t length, void (*found)(void *user, const char *filename), void *user) {
+  static const char include[] = "COMMENT \"include ";
+  const char *end = input + length;
+  for(const char *line = input; line < end; ) {
+    const char *line_end = memchr(line, '\n', end-line);
+    if(!line_end)
+      line_end = end;
+    size_t prefix = sizeof(include)-1;
+    if((size_t)(line_end-line) > prefix && !memcmp(line, include, prefix)) {
+      // same filename the converter will use: up to the closing quote
+      const char *name = line + prefix, *name_end = name;
+      while(name_end < line_end && *name_end != '"' && *name_end != '\r')
+        name_end++;
+      char filename[1024];
+      snprintf(filename, sizeof(filename), "%.*s", (int)(name_end-name), name);
+      found(user, filename);
+    }
+    line = line_end+1;
+  }
+}
+
+static void hash_include(void *user, const char *filename) {
+  uint64_t *hash = user;
+  size_t length = 0;
+  char *included = read_file(filename, &length);
+  *hash = ft2p_hash(*hash, filename, strlen(filename)+1);
+  if(included)
+    *hash = ft2p_hash(*hash, included, length);
+  else
+    *hash = ft2p_hash(*hash, "missing", 7);
+  free(included);
+}
+
+// a whole conversion's key covers the input, the options and every file the input includes
+static uint64_t conversion_key(const char *input, size_t length, const ft2p_options *options) {
+  static const char version[] = "ft2p cache 1";
+  uint64_t hash = ft2p_hash(FT2P_HASH_START, version, sizeof(version));
+  ft2p_options key_options = *options; // without the ones that don't change the result
+  key_options.pipeline = key_options.song_threads = key_options.stats = key_options.render_rate = 0;
+  hash = ft2p_hash(hash, &key_options, sizeof(key_options));
+  hash = ft2p_hash(hash, input, length);
+  find_includes(input, length, hash_include, &hash);
+  return hash;
+}
+
+// writes a file in the cache directory under a temporary name first, so that nobody sees half of it
+static void save_cache_file(const char *name, const void *data, size_t length) {
+  char filename[1024], temp_filename[1100];
+  snprintf(filename, sizeof(filename), "%s/%s", cache_directory, name);
+  pthread_mutex_lock(&cache_lock);
+  int number = cache_files_written++;
+  pthread_mutex_unlock(&cache_lock);
+  snprintf(temp_filename, sizeof(temp_filename), "%s.%ld.%i.tmp", filename, (long)getpid(), number);
+  FILE *file = fopen(temp_filename, "wb");
+  if(!file)
+    return;
+  int ok = fwrite(data, 1, length, file) == length;
+  if(fclose(file) || !ok || rename(temp_filename, filename))
+    remove(temp_filename);
+}
+
+static char *load_cache_file(const char *name, size_t *length) {
+  char filename[1024];
+  snprintf(filename, sizeof(filename), "%s/%s", cache_directory, name);
+  return read_file(filename, length);
+}
+
+static void *load_cached_song(void *user, uint64_t key, size_t *length) {
+  char name[40];
+  snprintf(name, sizeof(name), "song-%016llx", (unsigned long long)key);
+  return load_cache_file(name, length);
+}
+
+static void save_cached_song(void *user, uint64_t key, const void *data, size_t length) {
+  char name[40];
+  snprintf(name, sizeof(name), "song-%016llx", (unsigned long long)key);
+  save_cache_file(name, data, length);
+}
+
+// sink that sends warnings on to where they were going anyway, and keeps a copy for the cache
+typedef struct tee_sink {
+  ft2p_sink next;
+  textbuf copy;
+} tee_sink;
+
+static void write_tee(void *user, const char *data, size_t length) {
+  tee_sink *tee = user;
+  tee->next.write(tee->next.user, data, length);
+  write_textbuf(&tee->copy, data, length);
+}
+
+// swaps a binary module for its text export, so that the rest of the program only ever sees text
+static int read_module_input(ft2p_context *ctx, input_file *input) {
+  if(!ft2p_is_module(input->data, input->length))
+    return 0;
+  size_t length;
+  char *text = ft2p_read_module(ctx, input->data, input->length, &length);
+  if(!text)
+    return -1;
+  unload_input(input);
+  input->data = text;
+  input->length = length;
+  input->mapped = 0;
+  return 0;
+}
+
+// converts a loaded file into output_file; with -cache, a conversion that was done before is just copied,
+// and otherwise songs that were written before are reused
+static int convert_cached(ft2p_context *ctx, input_file *input, FILE *output_file, const ft2p_options *options) {
+  ft2p_sink output = {write_file, output_file};
+  if(read_module_input(ctx, input))
+    return -1;
+  if(!cache_directory)
+    return ft2p_convert(ctx, input->data, input->length, &output, options);
+
+  char output_name[40], log_name[40];
+  uint64_t key = conversion_key(input->data, input->length, options);
+  snprintf(output_name, sizeof(output_name), "%016llx.pently", (unsigned long long)key);
+  snprintf(log_name, sizeof(log_name), "%016llx.log", (unsigned long long)key);
+
+  // the reports, renders and maps of short names need a real conversion
+  if(!show_costs && !show_stats && !options->render_rate && !options->short_names) {
+    size_t output_length, log_length;
+    char *cached_output = load_cache_file(output_name, &output_length);
+    char *cached_log = cached_output ? load_cache_file(log_name, &log_length) : NULL;
+    if(cached_log) {
+      fwrite(cached_output, 1, output_length, output_file);
+      if(log_length)
+        ctx->log.write(ctx->log.user, cached_log, log_length);
+      free(cached_output);
+      free(cached_log);
+      return 0;
+    }
+    free(cached_output);
+  }
+
+  tee_sink tee = {ctx->log, {NULL, 0, 0}};
+  ctx->log.write = write_tee;
+  ctx->log.user = &tee;
+  ft2p_song_cache song_cache = {load_cached_song, save_cached_song, NULL};
+  ctx->song_cache = song_cache;
+  int result = ft2p_convert(ctx, input->data, input->length, NULL, options);
+  ctx->log = tee.next;
+  memset(&ctx->song_cache, 0, sizeof(ctx->song_cache));
+
+  output.write(output.user, ctx->out.data, ctx->out.length);
+  if(!result) {
+    save_cache_file(output_name, ctx->out.data, ctx->out.length);
+    save_cache_file(log_name, tee.copy.data ? tee.copy.data : "", tee.copy.length);
+  }
+  free(tee.copy.data);
+  return result;
+}
+
+//////////////////// watch mode ////////////////////
+#ifdef __linux__
+
+#define WATCH_DEBOUNCE_MS 100 // wait until saving has been quiet for this long
+#define MAX_WATCHED       64
+#define MEMORY_CACHE_SIZE 256
+
+// files to reconvert for; directories are watched instead of the files themselves,
+// because programs often save by writing a new file and renaming it over the old one
+typedef struct watched_file {
+  int wd;
+  char name[256];
+} watched_file;
+
+typedef struct watch {
+  int fd;
+  int num_files;
+  watched_file files[MAX_WATCHED];
+} watch;
+
+static void watch_file(void *user, const char *filename) {
+  watch *w = user;
+  if(w->num_files == MAX_WATCHED)
+    return;
+  char directory[1024];
+  const char *slash = strrchr(filename, '/');
+  if(slash)
+    snprintf(directory, sizeof(directory), "%.*s", slash == filename ? 1 : (int)(slash-filename), filename);
+  else
+    strcpy(directory, ".");
+  int wd = inotify_add_watch(w->fd, directory, IN_CLOSE_WRITE|IN_MOVED_TO|IN_CREATE|IN_DELETE);
+  if(wd < 0)
+    return;
+  watched_file *file = &w->files[w->num_files++];
+  file->wd = wd;
+  snprintf(file->name, sizeof(file->name), "%s", slash ? slash+1 : filename);
+}
+
+// reads the events that are waiting; returns 1 if any of them were for a watched file
+static int read_watch_events(watch *w) {
+  char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  int changed = 0;
+  ssize_t length = read(w->fd, buffer, sizeof(buffer));
+  for(char *next = buffer; length > 0 && next < buffer+length; ) {
+    struct inotify_event *event = (struct inotify_event*)next;
+    for(int i=0; i<w->num_files; i++)
+      if(w->files[i].wd == event->wd && event->len && !strcmp(w->files[i].name, event->name))
+        changed = 1;
+    next += sizeof(struct inotify_event) + event->len;
+  }
+  return changed;
+}
+
+// songs from earlier conversions, kept in memory when there's no -cache directory;
+// exporter threads load and save songs at the same time, so the ring is only touched under memory_cache_lock
+typedef struct memory_cache_entry {
+  uint64_t key;
+  void *data;
+  size_t length;
+} memory_cache_entry;
+
+static memory_cache_entry memory_cache[MEMORY_CACHE_SIZE];
+static int memory_cache_next;
+static pthread_mutex_t memory_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void *load_memory_song(void *user, uint64_t key, size_t *length) {
+  void *copy = NULL;
+  pthread_mutex_lock(&memory_cache_lock);
+  for(int i=0; i<MEMORY_CACHE_SIZE; i++)
+    if(memory_cache[i].data && memory_cache[i].key == key) {
+      copy = malloc(memory_cache[i].length);
+      if(copy) {
+        memcpy(copy, memory_cache[i].data, memory_cache[i].length);
+        *length = memory_cache[i].length;
+      }
+      break;
+    }
+  pthread_mutex_unlock(&memory_cache_lock);
+  return copy;
+}
+
+static void save_memory_song(void *user, uint64_t key, const void *data, size_t length) {
+  void *copy = malloc(length);
+  if(copy)
+    memcpy(copy, data, length);
+  pthread_mutex_lock(&memory_cache_lock);
+  memory_cache_entry *entry = &memory_cache[memory_cache_next];
+  memory_cache_next = (memory_cache_next+1) % MEMORY_CACHE_SIZE;
+  free(entry->data);
+  entry->data = copy;
+  entry->key = key;
+  entry->length = length;
+  pthread_mutex_unlock(&memory_cache_lock);
+}
+
+static double milliseconds_now(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+}
+
+// converts into a temporary file and renames it over the output, so the output is never half written
+// and a conversion that fails leaves the last good one in place; also starts watching the files involved
+static int convert_and_watch(ft2p_context *ctx, watch *w, const char *in_filename, const char *out_filename,
+                             const ft2p_options *options) {
+  // watch before converting so that saves during the conversion aren't missed
+  if(w->fd >= 0)
+    close(w->fd);
+  w->fd = inotify_init1(IN_NONBLOCK);
+  w->num_files = 0;
+  if(w->fd < 0) {
+    puts("Error: Couldn't start watching for changes");
+    return -1;
+  }
+  watch_file(w, in_filename);
+
+  input_file input;
+  if(load_input(&input, in_filename)) {
+    puts("Error: Input file couldn't be opened");
+    return -1;
+  }
+  if(read_module_input(ctx, &input)) {
+    printf("%s wasn't updated\n", out_filename);
+    unload_input(&input);
+    return -1;
+  }
+  find_includes(input.data, input.length, watch_file, w);
+
+  char temp_filename[1100];
+  snprintf(temp_filename, sizeof(temp_filename), "%s.%ld.tmp", out_filename, (long)getpid());
+  FILE *output_file = fopen(temp_filename, "wb");
+  if(!output_file) {
+    puts("Error: Output file couldn't be opened");
+    unload_input(&input);
+    return -1;
+  }
+  double start = milliseconds_now();
+  FILE *map_file = open_map(ctx, out_filename, options);
+  int result = convert_cached(ctx, &input, output_file, options);
+  if(map_file)
+    fclose(map_file);
+  unload_input(&input);
+  if(fclose(output_file))
+    result = -1;
+  if(result || rename(temp_filename, out_filename)) {
+    remove(temp_filename);
+    printf("%s wasn't updated\n", out_filename);
+    result = -1;
+  } else {
+    printf("Converted %s in %.1f ms\n", in_filename, milliseconds_now()-start);
+  }
+  fflush(stdout);
+  return result;
+}
+
+// converts the input, then again every time it or a file it includes changes, until interrupted
+static int run_watch(const char *in_filename, const char *out_filename, const ft2p_options *options) {
+  ft2p_context *ctx = ft2p_new();
+  if(!ctx) {
+    puts("Error: Out of memory");
+    return -1;
+  }
+  // unchanged songs don't need to be written again; a -cache directory does this too
+  if(!cache_directory) {
+    ft2p_song_cache song_cache = {load_memory_song, save_memory_song, NULL};
+    ctx->song_cache = song_cache;
+  }
+  ft2p_render_sink render = {write_render_file, (void*)out_filename};
+  ctx->render = render;
+  watch w = {-1, 0};
+  convert_and_watch(ctx, &w, in_filename, out_filename, options);
+
+  while(w.fd >= 0) {
+    struct pollfd wait = {w.fd, POLLIN, 0};
+    if(poll(&wait, 1, -1) <= 0 || !read_watch_events(&w))
+      continue;
+    // editors and trackers can touch a file several times while saving, so wait for them to finish
+    while(poll(&wait, 1, WATCH_DEBOUNCE_MS) > 0)
+      read_watch_events(&w);
+    convert_and_watch(ctx, &w, in_filename, out_filename, options);
+  }
+  ft2p_free(ctx);
+  return -1;
+}
+#endif
+
+//////////////////// batch mode ////////////////////
+
+// one file to convert
+typedef struct batch_job {
+  char *in_filename, *out_filename;
+  textbuf log;   // everything the conversion printed
+  int result;
+  int done;
+} batch_job;
+
+// the work shared between all the worker threads
+typedef struct batch {
+  batch_job *jobs;
+  int num_jobs, next_job;
+  const ft2p_options *options;
+  pthread_mutex_t lock;
+  pthread_cond_t job_done;
+} batch;
+
+// converts one file using a worker's converter, with all messages going into the job's log
+static int convert_file(ft2p_context *ctx, batch_job *job, const ft2p_options *options) {
+  ft2p_sink log = {write_textbuf, &job->log};
+  ctx->log = log;
+  ft2p_render_sink render = {write_render_file, job->out_filename};
+  ctx->render = render;
+
+  input_file input;
+  if(load_input(&input, job->in_filename)) {
+    append_text(&job->log, "Error: Input file couldn't be opened\n");
+    return -1;
+  }
+  FILE *output_file = fopen(job->out_filename, "wb");
+  if(!output_file) {
+    append_text(&job->log, "Error: Output file couldn't be opened\n");
+    unload_input(&input);
+    return -1;
+  }
+  FILE *map_file = open_map(ctx, job->out_filename, options);
+  int result = convert_cached(ctx, &input, output_file, options);
+  if(map_file)
+    fclose(map_file);
+  if(show_costs)
+    ft2p_write_costs(ctx, &log, report_json, costs_top);
+  if(show_stats)
+    ft2p_write_stats(ctx, &log, report_json);
+  unload_input(&input);
+  fclose(output_file);
+  return result;
+}
+
+// worker thread; keeps taking jobs until there aren't any left
+static void *batch_worker(void *arg) {
+  batch *b = arg;
+  ft2p_context *ctx = ft2p_new();
+
+  while(1) {
+    pthread_mutex_lock(&b->lock);
+    int index = b->next_job++;
+    pthread_mutex_unlock(&b->lock);
+    if(index >= b->num_jobs)
+      break;
+
+    batch_job *job = &b->jobs[index];
+    if(ctx)
+      job->result = convert_file(ctx, job, b->options);
+    else {
+      append_text(&job->log, "Error: Out of memory\n");
+      job->result = -1;
+    }
+
+    pthread_mutex_lock(&b->lock);
+    job->done = 1;
+    pthread_cond_broadcast(&b->job_done);
+    pthread_mutex_unlock(&b->lock);
+  }
+
+  ft2p_free(ctx);
+  return NULL;
+}
+
+// adds a job to the list
+static void add_job(batch *b, const char *in_filename, const char *out_filename) {
+  b->jobs = realloc(b->jobs, sizeof(batch_job) * (b->num_jobs+1));
+  batch_job *job = &b->jobs[b->num_jobs++];
+  memset(job, 0, sizeof(batch_job));
+  job->in_filename = strdup(in_filename);
+  job->out_filename = strdup(out_filename);
+}
+
+// reads a list of "input output" pairs, one pair per line
+static int read_job_list(batch *b, const char *filename) {
+  FILE *file = fopen(filename, "rb");
+  if(!file)
+    return -1;
+  char line[1024], in_filename[512], out_filename[512];
+  while(fgets(line, sizeof(line), file))
+    if(sscanf(line, "%511s %511s", in_filename, out_filename) == 2)
+      add_job(b, in_filename, out_filename);
+  fclose(file);
+  return 0;
+}
+
+// makes a job for every .txt file in a directory, writing a .pently file next to it
+static int read_job_directory(batch *b, const char *directory) {
+  DIR *dir = opendir(directory);
+  if(!dir)
+    return -1;
+  struct dirent *entry;
+  while((entry = readdir(dir))) {
+    size_t length = strlen(entry->d_name);
+    if(length < 5 || strcmp(entry->d_name+length-4, ".txt"))
+      continue;
+    char in_filename[1024], out_filename[1024];
+    snprintf(in_filename, sizeof(in_filename), "%s/%s", directory, entry->d_name);
+    snprintf(out_filename, sizeof(out_filename), "%s/%.*s.pently", directory, (int)length-4, entry->d_name);
+    add_job(b, in_filename, out_filename);
+  }
+  closedir(dir);
+  return 0;
+}
+
+// sorts jobs by input filename, so that directory listings come out in a predictable order
+static int compare_jobs(const void *a, const void *b) {
+  return strcmp(((const batch_job*)a)->in_filename, ((const batch_job*)b)->in_filename);
+}
+
+// converts every job using a pool of worker threads, printing each file's messages in order
+static int run_batch(batch *b, int num_threads) {
+  int i, result = 0;
+  if(num_threads > b->num_jobs)
+    num_threads = b->num_jobs;
+  if(num_threads < 1)
+    num_threads = 1;
+
+  pthread_t threads[num_threads];
+  pthread_mutex_init(&b->lock, NULL);
+  pthread_cond_init(&b->job_done, NULL);
+  for(i=0; i<num_threads; i++)
+    pthread_create(&threads[i], NULL, batch_worker, b);
+
+  // print messages in input order as soon as each job and the ones before it are done
+  for(i=0; i<b->num_jobs; i++) {
+    batch_job *job = &b->jobs[i];
+    pthread_mutex_lock(&b->lock);
+    while(!job->done)
+      pthread_cond_wait(&b->job_done, &b->lock);
+    pthread_mutex_unlock(&b->lock);
+
+    if(job->log.length) {
+      printf("%s:\n", job->in_filename);
+      fwrite(job->log.data, 1, job->log.length, stdout);
+    }
+    if(job->result)
+      result = -1;
+    free(job->log.data);
+    free(job->in_filename);
+    free(job->out_filename);
+  }
+
+  for(i=0; i<num_threads; i++)
+    pthread_join(threads[i], NULL);
+  pthread_mutex_destroy(&b->lock);
+  pthread_cond_destroy(&b->job_done);
+  free(b->jobs);
+  return result;
+}
+
+// guesses a good number of worker threads
+static int default_threads(void) {
+#ifdef _SC_NPROCESSORS_ONLN
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  if(count > 0)
+    return count;
+#endif
+  return 4;
+}
+
+int main(int argc, char *argv[]) {
+  const char *in_filename = NULL, *out_filename = NULL;
+  const char *batch_list = NULL, *batch_directory = NULL;
+  int num_threads = default_threads(), watch_mode = 0;
+  ft2p_options options;
+  memset(&options, 0, sizeof(options));
+
+  // read arguments
+  for(int i=1; i<argc; i++) {
+    if(!strcmp(argv[i], "-i"))
+      in_filename = argv[i+1];
+    if(!strcmp(argv[i], "-o"))
+      out_filename = argv[i+1];
+    if(!strcmp(argv[i], "-strict"))
+      options.strict = 1;
+    if(!strcmp(argv[i], "-hexrow"))
+      options.hex_rows = 1;
+    if(!strcmp(argv[i], "-dotted"))
+      options.dotted_durations = 1;
+    if(!strcmp(argv[i], "-autonoise"))
+      options.auto_noise = 1;
+    if(!strcmp(argv[i], "-autodualdrums"))
+      options.auto_dual_drums = 1;
+    if(!strcmp(argv[i], "-autodecay"))
+      options.decay_enabled = 1;
+    if(!strcmp(argv[i], "-pipeline"))
+      options.pipeline = 1;
+    if(!strcmp(argv[i], "-songthreads") && i+1 < argc)
+      options.song_threads = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-dedup"))
+      options.dedup_patterns = 1;
+    if(!strcmp(argv[i], "-transpose"))
+      options.transpose_patterns = 1;
+    if(!strcmp(argv[i], "-ca65"))
+      options.ca65 = 1;
+    if(!strcmp(argv[i], "-factor"))
+      options.factor_patterns = 1;
+    if(!strcmp(argv[i], "-mergeinst"))
+      options.merge_instruments = 1;
+    if(!strcmp(argv[i], "-render") && !options.render_rate)
+      options.render_rate = 44100;
+    if(!strcmp(argv[i], "-renderrate") && i+1 < argc)
+      options.render_rate = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-shortnames"))
+      options.short_names = 1;
+    if(!strcmp(argv[i], "-costs"))
+      show_costs = 1;
+    if(!strcmp(argv[i], "-stats"))
+      show_stats = options.stats = 1;
+    if(!strcmp(argv[i], "-json"))
+      report_json = 1;
+    if(!strcmp(argv[i], "-top") && i+1 < argc)
+      costs_top = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-budget") && i+1 < argc)
+      options.budget = atoi(argv[i+1]);
+    if(!strcmp(argv[i], "-watch"))
+      watch_mode = 1;
+    if(!strcmp(argv[i], "-cache") && i+1 < argc)
+      cache_directory = argv[i+1];
+    if(!strcmp(argv[i], "-batch") && i+1 < argc)
+      batch_list = argv[i+1];
+    if(!strcmp(argv[i], "-batchdir") && i+1 < argc)
+      batch_directory = argv[i+1];
+    if(!strcmp(argv[i], "-j") && i+1 < argc)
+      num_threads = atoi(argv[i+1]);
+  }
+
+  // convert many files at once if asked to
+  if(batch_list || batch_directory) {
+    batch b;
+    memset(&b, 0, sizeof(b));
+    b.options = &options;
+    if(batch_list && read_job_list(&b, batch_list)) {
+      printf("Error: Batch list \"%s\" couldn't be opened\n", batch_list);
+      return -1;
+    }
+    if(batch_directory) {
+      int first = b.num_jobs;
+      if(read_job_directory(&b, batch_directory)) {
+        printf("Error: Directory \"%s\" couldn't be opened\n", batch_directory);
+        return -1;
+      }
+      qsort(b.jobs+first, b.num_jobs-first, sizeof(batch_job), compare_jobs);
+    }
+    return run_batch(&b, num_threads);
+  }
+
+  // complain if input or output not specified
+  if(!in_filename || !out_filename) {
+    puts("syntax: ft2p -i input -o output");
+    puts("        ft2p -batch list.txt [-j threads]");
+    puts("        ft2p -batchdir directory [-j threads]");
+    return -1;
+  }
+
+  if(watch_mode) {
+#ifdef __linux__
+    return run_watch(in_filename, out_filename, &options);
+#else
+    puts("Error: -watch is only supported on Linux");
+    return -1;
+#endif
+  }
+
+  // start reading file
+  input_file input;
+  if(load_input(&input, in_filename)) {
+    puts("Error: Input file couldn't be opened");
+    return -1;
+  }
+  FILE *output_file = fopen(out_filename, "wb");
+  if(!output_file) {
+    puts("Error: Output file couldn't be opened");
+    return -1;
+  }
+
+  ft2p_context *ctx = ft2p_new();
+  if(!ctx) {
+    puts("Error: Out of memory");
+    return -1;
+  }
+  ft2p_render_sink render = {write_render_file, (void*)out_filename};
+  ctx->render = render;
+  FILE *map_file = open_map(ctx, out_filename, &options);
+  int result = convert_cached(ctx, &input, output_file, &options);
+  if(map_file)
+    fclose(map_file);
+  ft2p_sink report = {write_file, stdout};
+  if(show_costs)
+    ft2p_write_costs(ctx, &report, report_json, costs_top);
+  if(show_stats)
+    ft2p_write_stats(ctx, &report, report_json);
+
+  // close files
+  ft2p_free(ctx);
+  unload_input(&input);
+  fclose(output_file);
+  return result;
+}
@@ -1 +1 @@
-gcc ft2p.c -o ft2p -Wall -std=c99
+gcc ft2p.c main.c -o ft2p -Wall -std=c99 -pthread
@@ -0,0 +1,87 @@
+/*
+ * ft2pently
+ *
+ * Copyright (C) 2016-2018 NovaSquirrel
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+// Generates decay.h, the table ft2pently uses to recognize volume envelopes
+// that Pently's decay feature can replace: gcc mkdecay.c -o mkdecay && ./mkdecay > decay.h
+#include <stdio.h>
+#include "ft2p.h"
+
+#define MAX_NODES 4096
+#define NO_MATCH  255
+
+static int child[MAX_NODES][16];
+static int match[MAX_NODES];
+static int num_nodes = 1;
+
+int main(void) {
+  int i, j, k;
+  for(i=0; i<MAX_NODES; i++)
+    match[i] = NO_MATCH;
+
+  // try starting volumes in reverse order, and for each one the decay rates in order;
+  // the first decay in that order that fits an envelope is the one that gets used
+  for(i=MAX_DECAY_START-1; i>=2; i--)
+    for(j=0; j<MAX_DECAY_RATE; j++) {
+      char decay[MAX_DECAY_LEN];
+      int volume = (i+1)<<4;
+      int value, length = 0, rate = j+1;
+
+      while(volume >= 0x08) {
+        volume -= rate;
+        value = ((volume+8)>>4);
+        decay[length++] = value;
+      }
+      if(value == 0) // the zero at the end isn't part of the key
+        length--;
+
+      // add it to the trie backwards, so that envelopes can be looked up starting from their end
+      int node = 0;
+      for(k=length-1; k>=0; k--) {
+        if(!child[node][(int)decay[k]]) {
+          if(num_nodes == MAX_NODES) {
+            fputs("too many nodes\n", stderr);
+            return 1;
+          }
+          child[node][(int)decay[k]] = num_nodes++;
+        }
+        node = child[node][(int)decay[k]];
+      }
+      if(match[node] == NO_MATCH)
+        match[node] = (MAX_DECAY_START-1-i)*MAX_DECAY_RATE + j;
+    }
+
+  puts("// generated by mkdecay.c; don't edit\n"
+       "// trie of the volume envelopes that Pently's decay can make, read backwards from the zero at the end;\n"
+       "// decay_trie[node][volume] is the next node (0 if there's none), and decay_match[node] is\n"
+       "// (15-starting volume)*16 + (rate-1) for a decay that ends at that node, or 255\n"
+       "// (lower numbers are preferred when several decays fit)");
+  printf("#define DECAY_NO_MATCH %i\n\n", NO_MATCH);
+  printf("static const uint16_t decay_trie[%i][16] = {\n", num_nodes);
+  for(i=0; i<num_nodes; i++) {
+    printf("  {");
+    for(j=0; j<16; j++)
+      printf("%i%s", child[i][j], j<15 ? "," : "");
+    printf("}%s\n", i<num_nodes-1 ? "," : "");
+  }
+  puts("};\n");
+  printf("static const uint8_t decay_match[%i] = {", num_nodes);
+  for(i=0; i<num_nodes; i++)
+    printf("%s%i%s", i%32 ? "" : "\n  ", match[i], i<num_nodes-1 ? "," : "");
+  puts("\n};");
+  return 0;
+}